@@ -56,8 +56,27 @@ Java_net_kamkash_tilepuzzles_MainActivity_touchAction(JNIEnv *env, jobject thiz,
     touchAction(action, raw_x, raw_y);
 }
 
+extern "C"
+JNIEXPORT void JNICALL
+Java_net_kamkash_tilepuzzles_MainActivity_touchActions(JNIEnv *env, jobject thiz, jobject samples,
+                                                       jint count) {
+    touchActions(static_cast<const TouchSample *>(env->GetDirectBufferAddress(samples)), count);
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_net_kamkash_tilepuzzles_MainActivity_shuffle(JNIEnv *env, jobject thiz) {
     shuffle();
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_net_kamkash_tilepuzzles_MainActivity_solve(JNIEnv *env, jobject thiz) {
+    return solve();
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_net_kamkash_tilepuzzles_MainActivity_hint(JNIEnv *env, jobject thiz) {
+    return hint();
 }
\ No newline at end of file
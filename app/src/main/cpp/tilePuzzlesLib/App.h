@@ -9,8 +9,12 @@
 using namespace filament;
 
 namespace tilepuzzles {
+struct ResourceCache;
+
 struct App {
   Engine* engine;
+  // materials and textures shared by the renderers
+  ResourceCache* resources = nullptr;
   Scene* scene;
   Skybox* skybox;
   filament::Renderer* filaRenderer = nullptr;
@@ -0,0 +1,119 @@
+#ifndef _BOARD_STATE_H_
+#define _BOARD_STATE_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Logical puzzle state: which tile slot sits in which grid cell, and how far it is turned.
+// Tile slots are indexes into Mesh::tiles and equal the tile's solved cell, so the solved board is the
+// identity permutation. Moves only permute these arrays; geometry is derived from the dirty cells later.
+struct BoardState {
+  void init(int rows, int columns) {
+    this->rows = rows;
+    this->columns = columns;
+    const int count = rows * columns;
+    cells.resize(count);
+    slots.resize(count);
+    turns.assign(count, 0);
+    dirty.assign(count, 0);
+    dirtyCells.clear();
+    for (int i = 0; i < count; ++i) {
+      cells[i] = i;
+      slots[i] = i;
+    }
+  }
+
+  int size() const {
+    return cells.size();
+  }
+
+  int cell(int row, int column) const {
+    return row * columns + column;
+  }
+
+  int row(int cell) const {
+    return cell / columns;
+  }
+
+  int column(int cell) const {
+    return cell % columns;
+  }
+
+  bool contains(int row, int column) const {
+    return row >= 0 && column >= 0 && row < rows && column < columns;
+  }
+
+  int tileAt(int cell) const {
+    return cells[cell];
+  }
+
+  int cellOf(int slot) const {
+    return slots[slot];
+  }
+
+  int turnAt(int cell) const {
+    return turns[cell];
+  }
+
+  void place(int cell, int slot, int turn = 0) {
+    cells[cell] = slot;
+    slots[slot] = cell;
+    turns[cell] = turn;
+    markDirty(cell);
+  }
+
+  void swapCells(int a, int b) {
+    const int slotA = cells[a];
+    const int turnA = turns[a];
+    place(a, cells[b], turns[b]);
+    place(b, slotA, turnA);
+  }
+
+  bool isSolved() const {
+    for (int i = 0; i < size(); ++i) {
+      if (cells[i] != i || turns[i] != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void markDirty(int cell) {
+    if (!dirty[cell]) {
+      dirty[cell] = 1;
+      dirtyCells.push_back(cell);
+    }
+  }
+
+  void markAllDirty() {
+    for (int i = 0; i < size(); ++i) {
+      markDirty(i);
+    }
+  }
+
+  bool isDirty() const {
+    return !dirtyCells.empty();
+  }
+
+  template <typename F>
+  void flushDirty(F&& fn) {
+    for (int cell : dirtyCells) {
+      dirty[cell] = 0;
+      fn(cell);
+    }
+    dirtyCells.clear();
+  }
+
+  int rows = 0;
+  int columns = 0;
+  std::vector<uint16_t> cells;
+  std::vector<uint16_t> slots;
+  std::vector<uint8_t> turns;
+  std::vector<uint8_t> dirty;
+  std::vector<int> dirtyCells;
+};
+
+} // namespace tilepuzzles
+#endif
@@ -0,0 +1,302 @@
+#ifndef _ETC_CODEC_H_
+#define _ETC_CODEC_H_
+
+#include <algorithm>
+#include <limits.h>
+#include <stdint.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// ETC2 block codec for the texture baker. Color is written in the ETC1 individual and differential modes,
+// which ETC2 decoders read unchanged, and alpha as EAC. A block is 4x4 texels: 8 bytes of RGB8_ETC2, or 16
+// of RGBA8_ETC2_EAC with the alpha half first, each half a big endian 64 bit word. The search tries every
+// modifier table around the block average; decoding is there to check what the baker wrote.
+struct EtcCodec {
+  static constexpr int COLOR_TABLES[8][2] = {{2, 8},   {5, 17},  {9, 29},  {13, 42},
+                                             {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+  static constexpr int ALPHA_TABLES[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12}, {-3, -6, -8, -12, 2, 5, 7, 11},  {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},  {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},  {-2, -4, -8, -10, 1, 3, 7, 9},   {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},   {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+  // Bytes of one block.
+  static int blockSize(bool alpha) {
+    return alpha ? 16 : 8;
+  }
+
+  // Encodes a width x height RGBA image, rows of blocks from the top; edge blocks repeat the last texels.
+  static std::vector<uint8_t> encode(const uint8_t* rgba, int width, int height, bool alpha) {
+    const int bw = (width + 3) / 4;
+    const int bh = (height + 3) / 4;
+    std::vector<uint8_t> blocks(bw * bh * blockSize(alpha));
+    uint8_t* out = blocks.data();
+    uint8_t texels[64];
+    for (int by = 0; by < bh; ++by) {
+      for (int bx = 0; bx < bw; ++bx) {
+        for (int y = 0; y < 4; ++y) {
+          for (int x = 0; x < 4; ++x) {
+            const int sx = std::min(bx * 4 + x, width - 1);
+            const int sy = std::min(by * 4 + y, height - 1);
+            std::copy_n(rgba + (sy * width + sx) * 4, 4, texels + (y * 4 + x) * 4);
+          }
+        }
+        if (alpha) {
+          out = store(encodeAlpha(texels), out);
+        }
+        out = store(encodeColor(texels), out);
+      }
+    }
+    return blocks;
+  }
+
+  static std::vector<uint8_t> decode(const uint8_t* blocks, int width, int height, bool alpha) {
+    const int bw = (width + 3) / 4;
+    const int bh = (height + 3) / 4;
+    std::vector<uint8_t> rgba(width * height * 4);
+    uint8_t texels[64];
+    for (int by = 0; by < bh; ++by) {
+      for (int bx = 0; bx < bw; ++bx) {
+        std::fill_n(texels, 64, UINT8_MAX);
+        if (alpha) {
+          decodeAlpha(load(blocks), texels);
+          blocks += 8;
+        }
+        decodeColor(load(blocks), texels);
+        blocks += 8;
+        for (int y = 0; y < 4 && by * 4 + y < height; ++y) {
+          for (int x = 0; x < 4 && bx * 4 + x < width; ++x) {
+            std::copy_n(texels + (y * 4 + x) * 4, 4, rgba.data() + ((by * 4 + y) * width + bx * 4 + x) * 4);
+          }
+        }
+      }
+    }
+    return rgba;
+  }
+
+  // texels holds a block's 16 RGBA texels in row order. Fully transparent texels do not count.
+  static uint64_t encodeColor(const uint8_t* texels) {
+    int weights[16];
+    bool anyOpaque = false;
+    for (int i = 0; i < 16; ++i) {
+      anyOpaque |= texels[i * 4 + 3] != 0;
+    }
+    for (int i = 0; i < 16; ++i) {
+      weights[i] = !anyOpaque || texels[i * 4 + 3] != 0;
+    }
+
+    uint64_t best = 0;
+    int bestError = INT_MAX;
+    for (int flip = 0; flip < 2; ++flip) {
+      int average[2][3];
+      for (int sub = 0; sub < 2; ++sub) {
+        subblockAverage(texels, weights, flip, sub, average[sub]);
+      }
+      // individual: two 4 bit bases
+      {
+        int q[2][3];
+        int base[2][3];
+        for (int sub = 0; sub < 2; ++sub) {
+          for (int c = 0; c < 3; ++c) {
+            q[sub][c] = std::clamp((average[sub][c] * 15 + 127) / 255, 0, 15);
+            base[sub][c] = q[sub][c] << 4 | q[sub][c];
+          }
+        }
+        uint64_t block = uint64_t(q[0][0]) << 60 | uint64_t(q[1][0]) << 56 | uint64_t(q[0][1]) << 52 |
+                         uint64_t(q[1][1]) << 48 | uint64_t(q[0][2]) << 44 | uint64_t(q[1][2]) << 40;
+        const int error = fitSubblocks(texels, weights, flip, base, block);
+        if (error < bestError) {
+          bestError = error;
+          best = block | uint64_t(flip) << 32;
+        }
+      }
+      // differential: a 5 bit base and a 3 bit signed delta to the second
+      {
+        int q[2][3];
+        int base[2][3];
+        for (int c = 0; c < 3; ++c) {
+          q[0][c] = std::clamp((average[0][c] * 31 + 127) / 255, 0, 31);
+          const int q1 = std::clamp((average[1][c] * 31 + 127) / 255, 0, 31);
+          q[1][c] = std::clamp(q1 - q[0][c], -4, 3);
+          base[0][c] = expand5(q[0][c]);
+          base[1][c] = expand5(q[0][c] + q[1][c]);
+        }
+        uint64_t block = uint64_t(q[0][0]) << 59 | uint64_t(q[1][0] & 7) << 56 | uint64_t(q[0][1]) << 51 |
+                         uint64_t(q[1][1] & 7) << 48 | uint64_t(q[0][2]) << 43 | uint64_t(q[1][2] & 7) << 40;
+        const int error = fitSubblocks(texels, weights, flip, base, block);
+        if (error < bestError) {
+          bestError = error;
+          best = block | uint64_t(1) << 33 | uint64_t(flip) << 32;
+        }
+      }
+    }
+    return best;
+  }
+
+  static uint64_t encodeAlpha(const uint8_t* texels) {
+    int lo = UINT8_MAX;
+    int hi = 0;
+    for (int i = 0; i < 16; ++i) {
+      lo = std::min(lo, int(texels[i * 4 + 3]));
+      hi = std::max(hi, int(texels[i * 4 + 3]));
+    }
+    uint64_t best = 0;
+    int bestError = INT_MAX;
+    const int mid = (lo + hi + 1) / 2;
+    for (int base = std::max(0, mid - 8); base <= std::min(255, mid + 8) && bestError > 0; ++base) {
+      for (int table = 0; table < 16; ++table) {
+        for (int multiplier = 1; multiplier < 16; ++multiplier) {
+          int error = 0;
+          uint64_t indices = 0;
+          for (int p = 0; p < 16 && error < bestError; ++p) {
+            const int a = texels[((p & 3) * 4 + (p >> 2)) * 4 + 3];
+            int pixelError = INT_MAX;
+            int pixelIndex = 0;
+            for (int i = 0; i < 8; ++i) {
+              const int d = std::clamp(base + ALPHA_TABLES[table][i] * multiplier, 0, 255) - a;
+              if (d * d < pixelError) {
+                pixelError = d * d;
+                pixelIndex = i;
+              }
+            }
+            error += pixelError;
+            indices |= uint64_t(pixelIndex) << (45 - 3 * p);
+          }
+          if (error < bestError) {
+            bestError = error;
+            best = uint64_t(base) << 56 | uint64_t(multiplier) << 52 | uint64_t(table) << 48 | indices;
+          }
+        }
+      }
+    }
+    return best;
+  }
+
+  static void decodeColor(uint64_t block, uint8_t* texels) {
+    const bool diff = block >> 33 & 1;
+    const bool flip = block >> 32 & 1;
+    int base[2][3];
+    for (int c = 0; c < 3; ++c) {
+      if (diff) {
+        const int q = block >> (59 - 8 * c) & 31;
+        const int delta = int(block >> (56 - 8 * c) & 7) << 29 >> 29;
+        base[0][c] = expand5(q);
+        base[1][c] = expand5(q + delta);
+      } else {
+        base[0][c] = (block >> (60 - 8 * c) & 15) * 17;
+        base[1][c] = (block >> (56 - 8 * c) & 15) * 17;
+      }
+    }
+    const int tables[2] = {int(block >> 37 & 7), int(block >> 34 & 7)};
+    for (int x = 0; x < 4; ++x) {
+      for (int y = 0; y < 4; ++y) {
+        const int sub = (flip ? y : x) >> 1;
+        const int p = x * 4 + y;
+        const int modifier = COLOR_TABLES[tables[sub]][block >> p & 1] * ((block >> (16 + p) & 1) ? -1 : 1);
+        for (int c = 0; c < 3; ++c) {
+          texels[(y * 4 + x) * 4 + c] = std::clamp(base[sub][c] + modifier, 0, 255);
+        }
+      }
+    }
+  }
+
+  static void decodeAlpha(uint64_t block, uint8_t* texels) {
+    const int base = block >> 56;
+    const int multiplier = block >> 52 & 15;
+    const int table = block >> 48 & 15;
+    for (int p = 0; p < 16; ++p) {
+      const int index = block >> (45 - 3 * p) & 7;
+      texels[((p & 3) * 4 + (p >> 2)) * 4 + 3] = std::clamp(base + ALPHA_TABLES[table][index] * multiplier, 0, 255);
+    }
+  }
+
+  static int expand5(int q) {
+    return q << 3 | q >> 2;
+  }
+
+  static void subblockAverage(const uint8_t* texels, const int* weights, int flip, int sub, int* average) {
+    int sum[3] = {0, 0, 0};
+    int count = 0;
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        if (((flip ? y : x) >> 1) == sub && weights[y * 4 + x]) {
+          for (int c = 0; c < 3; ++c) {
+            sum[c] += texels[(y * 4 + x) * 4 + c];
+          }
+          ++count;
+        }
+      }
+    }
+    for (int c = 0; c < 3; ++c) {
+      average[c] = count ? (sum[c] + count / 2) / count : 0;
+    }
+  }
+
+  // Picks each subblock's table and texel modifiers for the given bases, adding them to block.
+  static int fitSubblocks(const uint8_t* texels, const int* weights, int flip, const int base[2][3],
+                          uint64_t& block) {
+    int total = 0;
+    for (int sub = 0; sub < 2; ++sub) {
+      int bestError = INT_MAX;
+      uint64_t bestBits = 0;
+      for (int table = 0; table < 8 && bestError > 0; ++table) {
+        int error = 0;
+        uint64_t bits = uint64_t(table) << (sub ? 34 : 37);
+        for (int x = 0; x < 4; ++x) {
+          for (int y = 0; y < 4; ++y) {
+            if (((flip ? y : x) >> 1) != sub) {
+              continue;
+            }
+            const uint8_t* texel = texels + (y * 4 + x) * 4;
+            int pixelError = INT_MAX;
+            int pixelIndex = 0;
+            for (int i = 0; i < 4; ++i) {
+              const int modifier = COLOR_TABLES[table][i & 1] * (i & 2 ? -1 : 1);
+              int e = 0;
+              for (int c = 0; c < 3; ++c) {
+                const int d = std::clamp(base[sub][c] + modifier, 0, 255) - texel[c];
+                e += d * d;
+              }
+              if (e < pixelError) {
+                pixelError = e;
+                pixelIndex = i;
+              }
+            }
+            error += pixelError * weights[y * 4 + x];
+            const int p = x * 4 + y;
+            bits |= uint64_t(pixelIndex & 1) << p | uint64_t(pixelIndex >> 1) << (16 + p);
+          }
+        }
+        if (error < bestError) {
+          bestError = error;
+          bestBits = bits;
+        }
+      }
+      total += bestError;
+      block |= bestBits;
+    }
+    return total;
+  }
+
+  static uint8_t* store(uint64_t word, uint8_t* out) {
+    for (int i = 0; i < 8; ++i) {
+      *out++ = word >> (56 - 8 * i);
+    }
+    return out;
+  }
+
+  static uint64_t load(const uint8_t* in) {
+    uint64_t word = 0;
+    for (int i = 0; i < 8; ++i) {
+      word = word << 8 | in[i];
+    }
+    return word;
+  }
+};
+
+} // namespace tilepuzzles
+#endif
@@ -12,6 +12,8 @@
 #include "Mesh.h"
 #include "TVertexBuffer.h"
 #include "Vertex.h"
+#include <array>
+#include <climits>
 #include <tuple>
 
 using namespace std;
@@ -21,6 +23,14 @@ using namespace filament::math;
 namespace tilepuzzles {
 
 struct HexSpinMesh : Mesh<TriangleVertexBuffer, HexTile> {
+  // A tile slot moving from one cell to another, turned by turn corners on the way.
+  struct CellMove {
+    uint16_t from;
+    uint16_t to;
+    uint8_t turn;
+  };
+  typedef std::vector<CellMove> MoveTable;
+
   HexSpinMesh() {
   }
 
@@ -71,17 +81,271 @@ struct HexSpinMesh : Mesh<TriangleVertexBuffer, HexTile> {
                      (rowGroup * columns) + colGroup, texWidth, indexOffset, {r, c}, t + 1,
                      GameUtil::TILE_DEPTH);
         tile.groupKey = key;
+        tile.dirtyRange = &vertexBuffer->dirty;
         addTile(tile);
         indexOffset += 3;
         ++t;
       }
     }
-    processAnchorGroups();
+    board.init(rows * 2, columns * 3);
+    initCellCorners();
+    initLatticeCells();
+    collectAnchors();
+    initLatticeAnchors();
+    initAnchorCells();
+    initMoveTables();
+    for (int anchIndex = 0; anchIndex < tileGroupAnchors.size(); ++anchIndex) {
+      updateAnchorGroup(anchIndex);
+    }
+  }
+
+  // Corners of every cell in the solved layout. Tiles are redrawn from these after each move.
+  void initCellCorners() {
+    cellCorners.resize(tiles.size());
+    for (int cell = 0; cell < tiles.size(); ++cell) {
+      for (int i = 0; i < 3; ++i) {
+        cellCorners[cell][i] = tiles[cell].getVert(i);
+      }
+    }
+  }
+
+  // Tile corners sit on a triangular lattice. In lattice coordinates, rows of triangles counted down from
+  // the top and tile sides across sheared by half a side per row, every corner is a whole point and each
+  // unit square holds two triangles either side of its diagonal. A point then finds its cell, or the
+  // corner next to it, with a couple of floors and a table lookup.
+  math::float2 toLattice(const math::float2& point) const {
+    const float row = (GameUtil::HIGH_Y - point.y) / tiles[0].size.y;
+    return {(point.x - GameUtil::LOW_X) / tiles[0].size.x + row * .5F - .5F, row};
+  }
+
+  void initLatticeCells() {
+    math::int2 low = {INT_MAX, INT_MAX};
+    math::int2 high = {INT_MIN, INT_MIN};
+    for (const auto& corners : cellCorners) {
+      for (const math::float3& corner : corners) {
+        const math::float2 p = toLattice({corner.x, corner.y});
+        low = min(low, math::int2(lround(p.x), lround(p.y)));
+        high = max(high, math::int2(lround(p.x), lround(p.y)));
+      }
+    }
+    latticeOrigin = low;
+    latticeSize = high - low;
+    latticeCells.assign(latticeSize.x * latticeSize.y * 2, -1);
+    for (int cell = 0; cell < cellCorners.size(); ++cell) {
+      const math::float3 center = cellCenter(cell);
+      latticeCells[latticeTriangle({center.x, center.y})] = cell;
+    }
+  }
+
+  void initLatticeAnchors() {
+    latticeAnchors.assign((latticeSize.x + 1) * (latticeSize.y + 1), -1);
+    for (int anchIndex = 0; anchIndex < tileGroupAnchors.size(); ++anchIndex) {
+      latticeAnchors[latticeCorner(tileGroupAnchors[anchIndex].anchorPoint)] = anchIndex;
+    }
+  }
+
+  // Slot in latticeCells of the triangle under the point, -1 off the lattice.
+  int latticeTriangle(const math::float2& point) const {
+    const math::float2 p = toLattice(point);
+    const int x = floor(p.x) - latticeOrigin.x;
+    const int y = floor(p.y) - latticeOrigin.y;
+    if (x < 0 || y < 0 || x >= latticeSize.x || y >= latticeSize.y) {
+      return -1;
+    }
+    const int upper = p.x - floor(p.x) > p.y - floor(p.y);
+    return (y * latticeSize.x + x) * 2 + upper;
+  }
+
+  // Slot in latticeAnchors of the corner nearest the point, -1 off the lattice.
+  int latticeCorner(const math::float2& point) const {
+    const math::float2 p = toLattice(point);
+    const int x = lround(p.x) - latticeOrigin.x;
+    const int y = lround(p.y) - latticeOrigin.y;
+    if (x < 0 || y < 0 || x > latticeSize.x || y > latticeSize.y) {
+      return -1;
+    }
+    return y * (latticeSize.x + 1) + x;
+  }
+
+  // Cells around each anchor, top row then bottom row, left to right, and the anchors around each cell.
+  // Anchors never move, so this is computed once.
+  void initAnchorCells() {
+    anchorCells.clear();
+    for (const auto& group : tileGroupAnchors) {
+      const math::float2 pt = group.anchorPoint;
+      std::vector<int> cells;
+      for (int cell = 0; cell < cellCorners.size(); ++cell) {
+        if (tiles[board.tileAt(cell)].hasVertex(pt)) {
+          cells.push_back(cell);
+        }
+      }
+      std::sort(cells.begin(), cells.end(), [this, &pt](int a, int b) {
+        const math::float3 ca = cellCenter(a);
+        const math::float3 cb = cellCenter(b);
+        const bool aTop = ca.y > pt.y;
+        const bool bTop = cb.y > pt.y;
+        return aTop != bTop ? aTop : ca.x < cb.x;
+      });
+      anchorCells.push_back(cells);
+    }
+    cellAnchors.assign(cellCorners.size(), {});
+    for (int anchIndex = 0; anchIndex < anchorCells.size(); ++anchIndex) {
+      for (int cell : anchorCells[anchIndex]) {
+        cellAnchors[cell].push_back(anchIndex);
+      }
+    }
+    anchorTouched.assign(anchorCells.size(), 0);
+  }
+
+  math::float3 cellCenter(int cell) const {
+    return (cellCorners[cell][0] + cellCorners[cell][1] + cellCorners[cell][2]) / 3.F;
+  }
+
+  virtual int cellAt(const math::float2& point) const {
+    const int triangle = latticeTriangle(point);
+    return triangle < 0 ? -1 : latticeCells[triangle];
+  }
+
+  // Adds a {from, to, turn} entry for each cell carried by a rigid move. Corner i of a cell lands on
+  // corner (i + turn) % 3 of its destination, so the tile's turn advances by that much.
+  template <typename F>
+  void collectMoves(const std::vector<int>& cells, F&& move, MoveTable& table) const {
+    for (int cell : cells) {
+      const math::float3 corner = move(cellCorners[cell][0]);
+      const math::float3 center = (corner + move(cellCorners[cell][1]) + move(cellCorners[cell][2])) / 3.F;
+      const int dst = cellAt({center.x, center.y});
+      int d = 0;
+      for (int i = 1; i < 3; ++i) {
+        if (GeoUtil::tdist(corner, cellCorners[dst][i]) < GeoUtil::tdist(corner, cellCorners[dst][d])) {
+          d = i;
+        }
+      }
+      table.push_back({(uint16_t)cell, (uint16_t)dst, (uint8_t)d});
+    }
+  }
+
+  // Tables for +/-60 degree turns of every anchor and for rolling every row and column of draggable
+  // groups either way. Moves are then plain slot permutations.
+  void initMoveTables() {
+    turnTables.assign(anchorCells.size(), {});
+    for (int anchIndex = 0; anchIndex < anchorCells.size(); ++anchIndex) {
+      const math::float2 pt = tileGroupAnchors[anchIndex].anchorPoint;
+      const math::float3 offset = -1. * math::float3({pt.x, pt.y, 0.});
+      for (int i = 0; i < 2; ++i) {
+        const float angle = i ? -GeoUtil::PI_3 : GeoUtil::PI_3;
+        collectMoves(anchorCells[anchIndex],
+                     [angle, &offset](const math::float3& p) {
+                       return GeoUtil::rotate(p, angle, {0., 0., 1.}, offset);
+                     },
+                     turnTables[anchIndex][i]);
+      }
+    }
+    const int rows = configMgr.config["dimension"]["rows"].get<int>();
+    const int columns = configMgr.config["dimension"]["columns"].get<int>();
+    rowRollTables.assign(rows, {});
+    for (int r = 0; r < rows; ++r) {
+      std::vector<const TileGroup<HexTile>*> groups;
+      for (int c = 0; c < columns; ++c) {
+        groups.push_back(tileGroupAt(r, c));
+      }
+      collectRollMoves(groups, rowRollTables[r]);
+    }
+    columnRollTables.assign(columns, {});
+    for (int c = 0; c < columns; ++c) {
+      std::vector<const TileGroup<HexTile>*> groups;
+      for (int r = 0; r < rows; ++r) {
+        groups.push_back(tileGroupAt(r, c));
+      }
+      collectRollMoves(groups, columnRollTables[c]);
+    }
+  }
+
+  // Every group of the line moves onto the anchor of the next one, [0] towards the end of the line.
+  void collectRollMoves(const std::vector<const TileGroup<HexTile>*>& groups,
+                        std::array<MoveTable, 2>& tables) const {
+    const int count = groups.size();
+    for (int i = 0; i < 2; ++i) {
+      const int shift = i ? count - 1 : 1;
+      for (int g = 0; g < count; ++g) {
+        const math::float2 src = groups[g]->anchorPoint;
+        const math::float2 dst = groups[(g + shift) % count]->anchorPoint;
+        const math::float3 delta = {dst.x - src.x, dst.y - src.y, 0.};
+        collectMoves(anchorCells[anchorIndexOf(src)],
+                     [&delta](const math::float3& p) { return GeoUtil::translate(p, delta); }, tables[i]);
+      }
+    }
+  }
+
+  void applyMoves(const MoveTable& table) {
+    movedSlots.resize(table.size());
+    for (int i = 0; i < table.size(); ++i) {
+      movedSlots[i] = {board.tileAt(table[i].from), (board.turnAt(table[i].from) + table[i].turn) % 3};
+    }
+    for (int i = 0; i < table.size(); ++i) {
+      board.place(table[i].to, movedSlots[i].x, movedSlots[i].y);
+      touchAnchorsOf(table[i].to);
+    }
+  }
+
+  void touchAnchorsOf(int cell) {
+    for (int anchIndex : cellAnchors[cell]) {
+      if (!anchorTouched[anchIndex]) {
+        anchorTouched[anchIndex] = 1;
+        touchedAnchors.push_back(anchIndex);
+      }
+    }
+  }
+
+  // The tiles now on the anchor's cells.
+  void updateAnchorGroup(int anchIndex) {
+    TileGroup<HexTile>& group = tileGroupAnchors[anchIndex];
+    group.clear();
+    for (int cell : anchorCells[anchIndex]) {
+      group.add(board.tileAt(cell));
+    }
+  }
+
+  virtual void updateTileGeometry(HexTile& tile, int cell) {
+    const int turn = board.turnAt(cell);
+    tile.gridCoord = {board.row(cell), board.column(cell)};
+    for (int i = 0; i < 3; ++i) {
+      (*tile.triangleVertices)[i].position = cellCorners[cell][(i + turn) % 3];
+    }
+    tile.markDirty();
+  }
+
+  int anchorIndexOf(const math::float2& point) const {
+    const int corner = latticeCorner(point);
+    const int anchIndex = corner < 0 ? -1 : latticeAnchors[corner];
+    if (anchIndex >= 0) {
+      const math::float2 pt = tileGroupAnchors[anchIndex].anchorPoint;
+      if (abs(pt.x - point.x) <= HexTile::EPS && abs(pt.y - point.y) <= HexTile::EPS) {
+        return anchIndex;
+      }
+    }
+    return -1;
   }
 
+  virtual TileGroup<HexTile>* hitTestAnchor(const math::float3& clipCoord) {
+    const int corner = latticeCorner({clipCoord.x, clipCoord.y});
+    const int anchIndex = corner < 0 ? -1 : latticeAnchors[corner];
+    if (anchIndex >= 0) {
+      const math::float2 pt = tileGroupAnchors[anchIndex].anchorPoint;
+      if (abs(pt.x - clipCoord.x) <= GeoUtil::EPS_4 && abs(pt.y - clipCoord.y) <= GeoUtil::EPS_4) {
+        return &tileGroupAnchors[anchIndex];
+      }
+    }
+    return nullptr;
+  }
+
+  // Refreshes only the groups around cells moved since the last call.
   virtual void processAnchorGroups() {
-    collectAnchors();
-    orderAnchorGroups();
+    updateGeometry();
+    for (int anchIndex : touchedAnchors) {
+      anchorTouched[anchIndex] = 0;
+      updateAnchorGroup(anchIndex);
+    }
+    touchedAnchors.clear();
   }
 
   virtual void collectAnchors() {
@@ -99,13 +363,14 @@ struct HexSpinMesh : Mesh<TriangleVertexBuffer, HexTile> {
         addAnchor(point, r, c);
       }
     }
+    indexTileGroups(configMgr.config["dimension"]["rows"].get<int>(),
+                    configMgr.config["dimension"]["columns"].get<int>());
   }
 
   virtual void addAnchor(const math::float2& point, int row, int col) {
-    std::vector<HexTile> anchTiles;
-    std::copy_if(tiles.begin(), tiles.end(), std::back_inserter(anchTiles),
-                 [&point](HexTile& t) { return t.hasVertex(point); });
-    if (anchTiles.size() == 6) {
+    const int anchTiles =
+      std::count_if(tiles.begin(), tiles.end(), [&point](const HexTile& t) { return t.hasVertex(point); });
+    if (anchTiles == 6) {
       bool canDrag = false;
       if (row % 2) {
         canDrag = col == 2 || col == 8;
@@ -119,68 +384,11 @@ struct HexSpinMesh : Mesh<TriangleVertexBuffer, HexTile> {
       }
       colGroup = canDrag ? colGroup : -1;
       rowGroup = canDrag ? rowGroup : -1;
-      TileGroup<HexTile> t(point, anchTiles, canDrag, {rowGroup, colGroup});
+      TileGroup<HexTile> t(point, canDrag, {rowGroup, colGroup});
       tileGroupAnchors.push_back(t);
     }
   }
 
-  virtual void orderAnchorGroups() {
-    const float sqrt3o2 = sqrt(3.) / 2.;
-    const int rows = configMgr.config["dimension"]["rows"].get<int>();
-    const int columns = configMgr.config["dimension"]["columns"].get<int>();
-    const float a = ((GameUtil::HIGH_X - GameUtil::LOW_X) / columns / 2.) * GameUtil::TILE_SCALE_FACTOR;
-    const float h = sqrt3o2 * a;
-    const Size size = {a, h};
-    int dragable = 0;
-    for (auto& group : tileGroupAnchors) {
-      if (group.dragable) {
-        std::vector<HexTile> tileGroup = std::vector<HexTile>();
-        math::float2 pt = group.anchorPoint;
-
-        // top half
-        float yCoord = pt.y + size.y * .5;
-        math::float3 tileCenter = {pt.x - size.x * .5, yCoord, 0.};
-        HexTile* tile = hitTest(tileCenter);
-        if (tile) {
-          tileGroup.push_back(*tile);
-        }
-
-        tileCenter = {pt.x, yCoord, 0.};
-        tile = hitTest(tileCenter);
-        if (tile) {
-          tileGroup.push_back(*tile);
-        }
-
-        tileCenter = {pt.x + size.x * .5, yCoord, 0.};
-        tile = hitTest(tileCenter);
-        if (tile) {
-          tileGroup.push_back(*tile);
-        }
-
-        // bottom half
-        yCoord = pt.y - size.y * .5;
-        tileCenter = {pt.x - size.x * .5, yCoord, 0.};
-        tile = hitTest(tileCenter);
-        if (tile) {
-          tileGroup.push_back(*tile);
-        }
-
-        tileCenter = {pt.x, yCoord, 0.};
-        tile = hitTest(tileCenter);
-        if (tile) {
-          tileGroup.push_back(*tile);
-        }
-
-        tileCenter = {pt.x + size.x * .5, yCoord, 0.};
-        tile = hitTest(tileCenter);
-        if (tile) {
-          tileGroup.push_back(*tile);
-        }
-        group.tileGroup = tileGroup;
-      }
-    }
-  }
-
   void addTile(const HexTile& tile) {
     tiles.push_back(tile);
   }
@@ -237,25 +445,79 @@ struct HexSpinMesh : Mesh<TriangleVertexBuffer, HexTile> {
   }
 
   virtual void rotateTileGroup(TileGroup<HexTile>& tileGroup, float angle) {
-    math::float2 pt = tileGroup.anchorPoint;
-    std::for_each(tileGroup.tileGroup.begin(), tileGroup.tileGroup.end(),
-                  [this, angle, &pt](HexTile& t) { t.rotateAtAnchor(pt, angle); });
+    const math::float2 pt = tileGroup.anchorPoint;
+    for (int slot : tileGroup) {
+      tiles[slot].rotateAtAnchor(pt, angle);
+    }
+  }
+
+  // Draws the group turned by angle from where its tiles rest on the board, so a drag never compounds
+  // rounding from earlier frames. Same sense as rotateTileGroup; the tiles keep their depth.
+  virtual void poseTileGroup(const TileGroup<HexTile>& tileGroup, float angle) {
+    const int anchIndex = anchorIndexOf(tileGroup.anchorPoint);
+    if (anchIndex < 0) {
+      return;
+    }
+    const math::float2 pt = tileGroup.anchorPoint;
+    const float c = cos(angle);
+    const float s = sin(angle);
+    for (int cell : anchorCells[anchIndex]) {
+      HexTile& tile = tiles[board.tileAt(cell)];
+      const int turn = board.turnAt(cell);
+      for (int i = 0; i < 3; ++i) {
+        const math::float3& rest = cellCorners[cell][(i + turn) % 3];
+        const float dx = rest.x - pt.x;
+        const float dy = rest.y - pt.y;
+        math::float3& position = (*tile.triangleVertices)[i].position;
+        position.x = pt.x + c * dx + s * dy;
+        position.y = pt.y - s * dx + c * dy;
+      }
+      tile.markDirty();
+    }
   }
 
   virtual void setTileGroupZCoord(TileGroup<HexTile>& tileGroup, float zCoord) {
-    std::for_each(tileGroup.tileGroup.begin(), tileGroup.tileGroup.end(),
-                  [zCoord](HexTile& t) { t.setVertexZCoord(zCoord); });
+    for (int slot : tileGroup) {
+      tiles[slot].setVertexZCoord(zCoord);
+    }
+  }
+
+  // Flags the group's vertices, through the normal channel, for the drag material to turn them.
+  virtual void setTileGroupDragged(TileGroup<HexTile>& tileGroup, bool dragged) {
+    const float flag = dragged ? 1.F : 0.F;
+    for (int slot : tileGroup) {
+      tiles[slot].updateNormals({flag, flag, flag});
+    }
+  }
+
+  virtual void turnTileGroup(const TileGroup<HexTile>& tileGroup, int steps) {
+    const int anchIndex = anchorIndexOf(tileGroup.anchorPoint);
+    if (anchIndex >= 0) {
+      // the group may have been rotated by a drag, so it is redrawn even when no turn is left
+      for (int cell : anchorCells[anchIndex]) {
+        board.markDirty(cell);
+      }
+      turnAnchor(anchIndex, steps);
+    }
+    processAnchorGroups();
+  }
+
+  // Turns the six cells around an anchor by steps * 60 degrees, same sense as rotateTileGroup.
+  void turnAnchor(int anchIndex, int steps) {
+    const MoveTable& table = turnTables[anchIndex][steps < 0 ? 1 : 0];
+    for (int i = 0; i < abs(steps) % 6; ++i) {
+      applyMoves(table);
+    }
   }
 
   virtual void shuffle() {
     int anchCount = tileGroupAnchors.size();
     for (int i = 0; i < HexSpinMesh::SHUFFLE_PASSES; ++i) {
-      float angle = GameUtil::coinFlip() ? GeoUtil::PI_3 : -GeoUtil::PI_3;
+      int steps = GameUtil::coinFlip() ? 1 : -1;
       int anchIndex = GameUtil::trand(0, anchCount);
-      auto anchor = tileGroupAnchors[anchIndex];
-      rotateTileGroup(anchor, angle);
-      processAnchorGroups();
+      turnAnchor(anchIndex, steps);
     }
+    processAnchorGroups();
   }
 
   std::vector<TileGroup<HexTile>*> tileGroupsToRoll(const TileGroup<HexTile>& groupPick, Direction dir) {
@@ -285,75 +547,37 @@ struct HexSpinMesh : Mesh<TriangleVertexBuffer, HexTile> {
   }
 
   virtual void rollTileGroups(const TileGroup<HexTile>& tileGroup, Direction dir) {
-    std::vector<TileGroup<HexTile>*> rollerGroups = tileGroupsToRoll(tileGroup, dir);
-
-    std::vector<TileDto> grp0;
-    if (dir == Direction::down || dir == Direction::right) {
-      grp0 = cloneTileGroup(*rollerGroups[0]);
-      for (int i = 0; i < rollerGroups.size() - 1; ++i) {
-        assignTileGroup(*rollerGroups[i + 1], *rollerGroups[i]);
-      }
-      assignTileGroup(grp0, *rollerGroups[rollerGroups.size() - 1]);
-    } else {
-      grp0 = cloneTileGroup(*rollerGroups[rollerGroups.size() - 1]);
-      for (int i = rollerGroups.size() - 2; i >= 0; --i) {
-        assignTileGroup(*rollerGroups[i], *rollerGroups[i + 1]);
-      }
-      assignTileGroup(grp0, *rollerGroups[0]);
+    const bool forward = dir == Direction::down || dir == Direction::right;
+    switch (dir) {
+      case Direction::down:
+      case Direction::up:
+        applyMoves(columnRollTables[tileGroup.gridCoord.y][forward ? 0 : 1]);
+        break;
+      case Direction::left:
+      case Direction::right:
+        applyMoves(rowRollTables[tileGroup.gridCoord.x][forward ? 0 : 1]);
+        break;
+      default:
+        break;
     }
     processAnchorGroups();
   }
 
-  std::vector<TileDto> cloneTileGroup(const TileGroup<HexTile>& srcGrp) {
-    std::vector<TileDto> grp;
-    std::transform(srcGrp.tileGroup.begin(), srcGrp.tileGroup.end(), std::back_inserter(grp),
-                   [](const HexTile& hexTile) {
-                     TileDto dto = hexTile.clone();
-                     return dto;
-                   });
-
-    return grp;
-  }
-
-  virtual void rollTileGroups1(const TileGroup<HexTile>& tileGroup, Direction dir) {
-    std::vector<TileGroup<HexTile>*> rollerGroups = tileGroupsToRoll(tileGroup, dir);
-    std::for_each(rollerGroups.begin(), rollerGroups.end(), [this, dir](TileGroup<HexTile>* g) {
-      if (g) {
-        translateTileGroup(g->tileGroup, dir);
-      }
-    });
-    processAnchorGroups();
-  }
-
-  void translateTileGroup(std::vector<HexTile>& shiftTiles, Direction dir) {
-    const int rows = configMgr.config["dimension"]["rows"].get<int>();
-    const int columns = configMgr.config["dimension"]["columns"].get<int>();
-    std::for_each(shiftTiles.begin(), shiftTiles.end(), [dir, rows, columns](auto& t) {
-      //
-      t.translate(dir, rows, columns);
-    });
-  }
-
-  void assignTileGroup(const TileGroup<HexTile>& srcGroup, const TileGroup<HexTile>& dstGroup) {
-    std::vector<HexTile> srcTiles = srcGroup.tileGroup;
-    std::vector<HexTile> dstTiles = dstGroup.tileGroup;
-    for (int i = 0; i < srcTiles.size(); ++i) {
-      auto src = srcTiles[i];
-      auto dst = dstTiles[i];
-      dst.assign(&src);
-    }
-  }
-
-  void assignTileGroup(const std::vector<TileDto>& srcGroup, const TileGroup<HexTile>& dstGroup) {
-    std::vector<HexTile> dstTiles = dstGroup.tileGroup;
-    for (int i = 0; i < srcGroup.size(); ++i) {
-      const TileDto& src = srcGroup[i];
-      HexTile& dst = dstTiles[i];
-      dst.assign(src);
-    }
-  }
-
   static constexpr int SHUFFLE_PASSES = 400;
+
+  std::vector<std::array<math::float3, 3>> cellCorners;
+  math::int2 latticeOrigin;
+  math::int2 latticeSize;
+  std::vector<int> latticeCells;
+  std::vector<int> latticeAnchors;
+  std::vector<std::vector<int>> anchorCells;
+  std::vector<std::array<MoveTable, 2>> turnTables;
+  std::vector<std::array<MoveTable, 2>> rowRollTables;
+  std::vector<std::array<MoveTable, 2>> columnRollTables;
+  std::vector<math::int2> movedSlots;
+  std::vector<std::vector<int>> cellAnchors;
+  std::vector<uint8_t> anchorTouched;
+  std::vector<int> touchedAnchors;
 };
 
 } // namespace tilepuzzles
@@ -35,11 +35,14 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
   }
 
   virtual Path getTileMaterialPath() {
-    return IOUtil::getMaterialPath(FILAMAT_FILE_OPAQUE.data());
+    return IOUtil::getMaterialPath(gpuDrag ? FILAMAT_FILE_GROUP_DRAG.data() : FILAMAT_FILE_OPAQUE.data());
   }
 
   virtual void initMesh() {
     mesh->init(CFG);
+    // like the instanced material, the group drag one ships only once compiled
+    gpuDrag = mesh->renderGpuDrag() && !mesh->renderInstanced() &&
+              IOUtil::assetExists(IOUtil::getMaterialPath(FILAMAT_FILE_GROUP_DRAG.data()));
   }
 
   virtual HexTile* onRightMouseDown(const float2& viewCoord) {
@@ -54,37 +57,37 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
   }
 
   void handleTileDrag(math::float3 clipCoord) {
-    float2 anchor = dragAnchor.anchorPoint;
-      math::float3 anchVec = {dragTile->size.x, 0., 0.};
-      math::float3 posVec = GeoUtil::translate(clipCoord, -1. * math::float3(anchor.x, anchor.y, 0.));
-      math::float3 pNormal = GeoUtil::tcross(anchVec, posVec);
-
-      float angle = 0.F;
-      if (abs(pNormal.z) > HexTile::EPS && abs(pNormal.z - lastNormalVec.z) > HexTile::EPS) {
-        if (posVec.y > anchVec.y) {
-          if (pNormal.z > lastNormalVec.z) {
-            // normal increase in top-right-left quadrant
-            angle = posVec.x >= 0 ? -ROTATION_ANGLE : ROTATION_ANGLE;
-          } else {
-            // normal decrease in top-right-left quadrant
-            angle = posVec.x >= 0 ? ROTATION_ANGLE : -ROTATION_ANGLE;
-          }
-        } else {
-          if (pNormal.z > lastNormalVec.z) {
-            // normal increase in bottom-right-left quadrant
-            angle = posVec.x >= 0 ? -ROTATION_ANGLE : ROTATION_ANGLE;
-          } else {
-            // normal decrease in bottom-right-left quadrant
-            angle = posVec.x >= 0 ? ROTATION_ANGLE : -ROTATION_ANGLE;
-          }
-        }
-      }
-      if (angle != 0.F) {
-        rotationAngle += angle;
-        mesh->rotateTileGroup(dragAnchor, angle);
-        needsDraw = true;
-      }
-      lastNormalVec = pNormal;
+    trackTileDrag(clipCoord);
+    poseDraggedGroup();
+  }
+
+  // The group follows the pointer's angle around the anchor, turned back the other way in rotateTileGroup's
+  // sense. Each step is wrapped to half a turn, so whole revolutions add up.
+  void trackTileDrag(math::float3 clipCoord) {
+    const float dx = clipCoord.x - dragPoint.x;
+    const float dy = clipCoord.y - dragPoint.y;
+    if (dx * dx + dy * dy < GRAB_RADIUS * GRAB_RADIUS * dragTile->size.x * dragTile->size.x) {
+      return;
+    }
+    const float pointerAngle = atan2(dy, dx);
+    float delta = pointerAngle - lastPointerAngle;
+    if (delta > math::F_PI) {
+      delta -= 2.F * math::F_PI;
+    } else if (delta < -math::F_PI) {
+      delta += 2.F * math::F_PI;
+    }
+    lastPointerAngle = pointerAngle;
+    rotationAngle -= delta;
+  }
+
+  void poseDraggedGroup() {
+    if (gpuDrag) {
+      matInstance->setParameter("dragAngle", rotationAngle);
+      viewChanged = true;
+    } else {
+      mesh->poseTileGroup(dragAnchor, rotationAngle);
+      needsDraw = true;
+    }
   }
 
   void handleAnchorDrag(math::float3 clipCoord) {
@@ -115,6 +118,23 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
     }
   }
 
+  // Every point is tracked so fast turns keep their revolutions, but the group is posed once for the path.
+  virtual void onMouseDrag(const float2* path, int count) {
+    if (!dragTile || readOnly) {
+      return;
+    }
+    if (dragAction == DragAction::TileDrag) {
+      for (int i = 0; i < count; ++i) {
+        trackTileDrag(normalizeViewCoord(path[i]));
+      }
+      poseDraggedGroup();
+    } else if (dragAction == DragAction::AnchorDrag) {
+      for (int i = 0; i < count; ++i) {
+        handleAnchorDrag(normalizeViewCoord(path[i]));
+      }
+    }
+  }
+
   virtual HexTile* onMouseDown(const math::float2& pos) {
     math::float3 clipCoord = normalizeViewCoord(pos);
     dragTile = mesh->hitTest(clipCoord);
@@ -126,13 +146,17 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
       dragPoint = dragAnchor.anchorPoint;
     } else if (dragTile) {
       dragAction = DragAction::TileDrag;
-      dragAnchor = mesh->nearestAnchorGroup({clipCoord.x, clipCoord.y});
+      dragAnchor = *mesh->nearestAnchorGroup({clipCoord.x, clipCoord.y});
       dragPoint = dragAnchor.anchorPoint;
-      math::float3 anchVec = {dragTile->size.x, 0., 0.};
-      math::float3 posVec = GeoUtil::translate(clipCoord, -1. * math::float3(dragPoint.x, dragPoint.y, 0.));
-      math::float3 pNormal = GeoUtil::tcross(anchVec, posVec);
-      lastNormalVec = pNormal;
+      lastPointerAngle = atan2(clipCoord.y - dragPoint.y, clipCoord.x - dragPoint.x);
       mesh->setTileGroupZCoord(dragAnchor, GameUtil::RAISED_TILE_DEPTH);
+      if (gpuDrag) {
+        mesh->setTileGroupDragged(dragAnchor, true);
+        // the vertex shader turns positions as uploaded, before the renderable's scale
+        matInstance->setParameter("dragAnchor", dragAnchor.anchorPoint / TriangleVertexBuffer::POSITION_SCALE);
+        matInstance->setParameter("dragAngle", 0.F);
+      }
+      needsDraw = true;
     }
     }
     return dragTile;
@@ -141,61 +165,26 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
   virtual HexTile* onMouseUp(const math::float2& pos) {
     math::float3 clipCoord = normalizeViewCoord(pos);
     if (dragTile) {
-    float angle = snapToAngle();
-    if (angle != 0.) {
-      mesh->rotateTileGroup(dragAnchor, angle);
-      snapToPosition();
+      if (gpuDrag) {
+        mesh->setTileGroupDragged(dragAnchor, false);
+        matInstance->setParameter("dragAngle", 0.F);
+      }
+      // the turn redraws the group's cells from their rest corners, depth included, so whatever the drag
+      // left behind is gone
+      mesh->turnTileGroup(dragAnchor, snapSteps());
       needsDraw = true;
-    }
-    rotationAngle = 0.f;
-    dragTile = nullptr;
+      rotationAngle = 0.f;
+      dragTile = nullptr;
       dragAction = DragAction::noDrag;
-      mesh->setTileGroupZCoord(dragAnchor, GameUtil::TILE_DEPTH);
-      mesh->processAnchorGroups();
     }
 
     HexTile* tile = mesh->hitTest(clipCoord);
     return tile;
   }
 
-  float snapToAngle() {
-    float angle = 0.;
-    float angleMultiple = std::abs(rotationAngle / PI_3);
-    if (angleMultiple >= 0.5) {
-      angleMultiple -= std::floor(angleMultiple);
-      angleMultiple = ceil(angleMultiple * 1000.) / 1000.;
-      if (rotationAngle >= 0) {
-        angle = (angleMultiple >= 0.5) ? PI_3 - angleMultiple : -angleMultiple;
-      } else {
-        angle = (angleMultiple >= 0.5) ? -(PI_3 - angleMultiple) : angleMultiple;
-      }
-      angle = ceil(angle * 1000.) / 1000.;
-    } else {
-      // snap back
-      angle = -rotationAngle;
-    }
-    return angle;
-  }
-
-  void snapToPosition() {
-    std::for_each(mesh->tiles.begin(), mesh->tiles.end(), [this](const HexTile& anchTileTarget) {
-      std::for_each(mesh->tiles.begin(), mesh->tiles.end(), [&anchTileTarget](const HexTile& anchTile) {
-        Vertex* targetVerts = *anchTileTarget.triangleVertices;
-        Vertex* srcVerts = *anchTile.iniTriangleVertices;
-        if (abs(targetVerts[0].position.x - srcVerts[0].position.x) <= EPS)
-          targetVerts[0].position.x = srcVerts[0].position.x;
-        if (abs(targetVerts[0].position.y - srcVerts[0].position.y) <= EPS)
-          targetVerts[0].position.y = srcVerts[0].position.y;
-        if (abs(targetVerts[1].position.x - srcVerts[1].position.x) <= EPS)
-          targetVerts[1].position.x = srcVerts[1].position.x;
-        if (abs(targetVerts[1].position.y - srcVerts[1].position.y) <= EPS)
-          targetVerts[1].position.y = srcVerts[1].position.y;
-        if (abs(targetVerts[2].position.x - srcVerts[2].position.x) <= EPS)
-          targetVerts[2].position.x = srcVerts[2].position.x;
-        if (abs(targetVerts[2].position.y - srcVerts[2].position.y) <= EPS)
-          targetVerts[2].position.y = srcVerts[2].position.y;
-      });
-    });
+  // Nearest whole number of 60 degree turns to the dragged angle.
+  int snapSteps() const {
+    return lround(rotationAngle / PI_3);
   }
 
   virtual Path getTilesTexturePath() {
@@ -213,6 +202,15 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
     return path;
   }
 
+  virtual void prepare(ResourceCache& resources, ThreadPool& pool) {
+    TRenderer::prepare(resources, pool);
+    if (!readOnly) {
+      resources.prefetchMaterial(getAnchorMaterialPath(), pool);
+      resources.prefetchTexture(getAnchorTexturePath(), pool);
+      resources.prefetchTexture(getAnchor2TexturePath(), pool);
+    }
+  }
+
   virtual void draw() {
     TRenderer::draw();
     if (!readOnly) {
@@ -223,56 +221,27 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
   void drawAnchors() {
     static_assert(sizeof(Vertex) == (4 * 3) + (4 * 3) + (4 * 2), "Strange vertex size.");
 
-    Path matPath = getAnchorMaterialPath();
-    std::vector<unsigned char> mat = IOUtil::loadBinaryAsset(matPath.c_str());
-    anchMaterial = Material::Builder().package(mat.data(), mat.size()).build(*engine);
+    anchMaterial = resources->acquireMaterial(getAnchorMaterialPath());
     anchMatInstance = anchMaterial->createInstance();
     
     ///////////////////////////// albedo
-    Path path = getAnchorTexturePath();
-    IOUtil::img_data data = IOUtil::imageLoad(path.c_str(), 4);
-    Texture::PixelBufferDescriptor buffer(data.data, size_t(data.width * data.height * 4),
-                                          Texture::Format::RGBA, Texture::Type::UBYTE,
-                                          (Texture::PixelBufferDescriptor::Callback) & ::stbi_image_free);
-    anchTex = Texture::Builder()
-                .width(uint32_t(data.width))
-                .height(uint32_t(data.height))
-                .levels(1)
-                .sampler(Texture::Sampler::SAMPLER_2D)
-                .format(Texture::InternalFormat::RGBA8)
-                .build(*engine);
-    anchTex->setImage(*engine, 0, std::move(buffer));
-    TextureSampler sampler(MinFilter::LINEAR, MagFilter::LINEAR);
+    anchTex = resources->acquireTexture(getAnchorTexturePath());
+    TextureSampler sampler(MinFilter::LINEAR_MIPMAP_LINEAR, MagFilter::LINEAR);
     anchMatInstance->setParameter("albedo", anchTex, sampler);
 
     ///////////////////////////// albedo1
-    path = getAnchor2TexturePath();
-    data = IOUtil::imageLoad(path.c_str(), 4);
-    Texture::PixelBufferDescriptor buffer1(data.data, size_t(data.width * data.height * 4),
-                                           Texture::Format::RGBA, Texture::Type::UBYTE,
-                                           (Texture::PixelBufferDescriptor::Callback) & ::stbi_image_free);
-    anchTex1 = Texture::Builder()
-                 .width(uint32_t(data.width))
-                 .height(uint32_t(data.height))
-                 .levels(1)
-                 .sampler(Texture::Sampler::SAMPLER_2D)
-                 .format(Texture::InternalFormat::RGBA8)
-                 .build(*engine);
-    anchTex1->setImage(*engine, 0, std::move(buffer1));
-    TextureSampler sampler1(MinFilter::LINEAR, MagFilter::LINEAR);
+    anchTex1 = resources->acquireTexture(getAnchor2TexturePath());
+    TextureSampler sampler1(MinFilter::LINEAR_MIPMAP_LINEAR, MagFilter::LINEAR);
     anchMatInstance->setParameter("albedo1", anchTex1, sampler1);
 
     // Create quad renderable
-    anchVb = VertexBuffer::Builder()
-               .vertexCount(mesh->vertexBufferAnchors->numVertices)
-               .bufferCount(1)
-               .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, 32)
-               .attribute(VertexAttribute::CUSTOM0, 0, VertexBuffer::AttributeType::FLOAT3, 12, 32)
-               .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT3, 24, 32)
+    VertexBuffer::Builder builder;
+    anchVb = TQuadVertexBuffer::declare(builder.vertexCount(mesh->vertexBufferAnchors->numVertices).bufferCount(1))
                .build(*engine);
     anchVb->setBufferAt(*engine, 0,
-                        VertexBuffer::BufferDescriptor(mesh->vertexBufferAnchors->vertShapes,
-                                                       mesh->vertexBufferAnchors->getSize(), nullptr));
+                        VertexBuffer::BufferDescriptor(mesh->vertexBufferAnchors->clonePacked(),
+                                                       mesh->vertexBufferAnchors->packedSize(),
+                                                       (VertexBuffer::BufferDescriptor::Callback)free));
     anchIb = IndexBuffer::Builder()
                .indexCount(mesh->vertexBufferAnchors->numIndices)
                .bufferType(IndexBuffer::IndexType::USHORT)
@@ -291,6 +260,7 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
                 mesh->vertexBufferAnchors->numIndices)
       .culling(false)
       .build(*engine, anchRenderable);
+    scaleToBoard(anchRenderable);
     scene->addEntity(anchRenderable);
 
     // Add light sources into the scene.
@@ -312,9 +282,9 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
       // engine->destroy(anchLight);
     engine->destroy(anchRenderable);
     engine->destroy(anchMatInstance);
-    engine->destroy(anchTex);
-    engine->destroy(anchTex1);
-    engine->destroy(anchMaterial);
+    resources->release(anchTex);
+    resources->release(anchTex1);
+    resources->release(anchMaterial);
     engine->destroy(anchVb);
     engine->destroy(anchIb);
     }
@@ -322,7 +292,7 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
   }
 
   void logGroupDepth(const std::string& msg) {
-    std::for_each(dragAnchor.tileGroup.begin(), dragAnchor.tileGroup.end(), [this](HexTile& t) {});
+    std::for_each(dragAnchor.begin(), dragAnchor.end(), [this](int slot) {});
   }
 
   VertexBuffer* anchVb;
@@ -337,10 +307,13 @@ struct HexSpinRenderer : TRenderer<TriangleVertexBuffer, HexTile> {
   math::float2 dragPoint;
   DragAction dragAction = DragAction::noDrag;
   float rotationAngle = 0.;
+  float lastPointerAngle = 0.;
+  // dragged group turned by the material from the dragAnchor and dragAngle parameters
+  bool gpuDrag = false;
 
-  static constexpr float ROTATION_ANGLE = math::F_PI / 35.;
+  // pointer positions this close to the anchor, in tile widths, leave the angle alone
+  static constexpr float GRAB_RADIUS = .25F;
   static constexpr float PI_3 = math::F_PI / 3.;
-  constexpr static float EPS = 0.1F;
   static constexpr const char* CFG = R"({
     "type":"HexSpinner",
       "dimension": {
@@ -59,6 +59,7 @@ struct HexTile : Tile {
     (*triangleVertices)[0].position = (*other->triangleVertices)[0].position;
     (*triangleVertices)[1].position = (*other->triangleVertices)[1].position;
     (*triangleVertices)[2].position = (*other->triangleVertices)[2].position;
+    markDirty();
 
     (*iniTriangleVertices)[0].position = (*other->iniTriangleVertices)[0].position;
     (*iniTriangleVertices)[1].position = (*other->iniTriangleVertices)[1].position;
@@ -72,6 +73,7 @@ struct HexTile : Tile {
     (*triangleVertices)[0].position = (*dto.triangleVertices)[0].position;
     (*triangleVertices)[1].position = (*dto.triangleVertices)[1].position;
     (*triangleVertices)[2].position = (*dto.triangleVertices)[2].position;
+    markDirty();
 
     (*iniTriangleVertices)[0].position = (*dto.iniTriangleVertices)[0].position;
     (*iniTriangleVertices)[1].position = (*dto.iniTriangleVertices)[1].position;
@@ -92,6 +94,7 @@ struct HexTile : Tile {
       (*triangleVertices)[1].position.y = 1. - (*triangleVertices)[1].position.y - shift;
       (*triangleVertices)[2].position.y = 1. - (*triangleVertices)[2].position.y - shift;
     }
+    markDirty();
 
     switch (dir) {
       case Direction::up: {
@@ -130,6 +133,7 @@ struct HexTile : Tile {
   virtual void updateNormals(const math::float3 norm) {
     (*triangleVertices)[0].normal = (*triangleVertices)[1].normal =
       (*triangleVertices)[2].normal = norm;
+    markDirty();
   }
 
   virtual void updateVertices() {
@@ -183,6 +187,7 @@ struct HexTile : Tile {
         (*triangleVertices)[2].position = tri[2];
       }
     }
+    markDirty();
 
     if (iniTriangleVertices == nullptr) {
       iniTriangleVertices = (TriangleVertices*)malloc(sizeof(TriangleVertices));
@@ -194,11 +199,13 @@ struct HexTile : Tile {
     (*triangleVertices)[0].texCoords = {texWidth * texIndex, 0};
     (*triangleVertices)[1].texCoords = {texWidth * (texIndex + .9), 0};
     (*triangleVertices)[2].texCoords = {texWidth * (texIndex + .9), .4};
+    markDirty();
   }
 
   virtual void setVertexZCoord(float zCoord) {
     (*triangleVertices)[0].position.z = (*triangleVertices)[1].position.z =
       (*triangleVertices)[2].position.z = zCoord;
+    markDirty();
     }
 
   /* A utility function to calculate area of triangle formed by (x1, y1),
@@ -259,19 +266,24 @@ struct HexTile : Tile {
     (*triangleVertices)[0].position = rotTri[0];
     (*triangleVertices)[1].position = rotTri[1];
     (*triangleVertices)[2].position = rotTri[2];
+    markDirty();
+  }
+
+  virtual const void* shape() const {
+    return triangleVertices;
   }
 
   bool inverted() {
     return (*triangleVertices)[2].position[1] < (*triangleVertices)[0].position[1];
   }
 
-  virtual bool hasVertex(const math::float2& vert) {
+  virtual bool hasVertex(const math::float2& vert) const {
     return (abs(getVert(0).x - vert.x) <= EPS && abs(getVert(0).y - vert.y) <= EPS) ||
            (abs(getVert(1).x - vert.x) <= EPS && abs(getVert(1).y - vert.y) <= EPS) ||
            (abs(getVert(2).x - vert.x) <= EPS && abs(getVert(2).y - vert.y) <= EPS);
   }
 
-  virtual math::float3 getVert(int index) {
+  virtual math::float3 getVert(int index) const {
     return (*triangleVertices)[index].position;
   }
 
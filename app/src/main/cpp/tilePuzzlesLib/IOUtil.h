@@ -1,6 +1,7 @@
 #ifndef _IO_UTIL_H_
 #define _IO_UTIL_H_
 
+#include <fcntl.h>
 #include <stdlib.h>
 #include <fstream>
 #include <time.h>
@@ -18,6 +19,7 @@
 #endif
 
 #include "tilePuzzelsLib.h"
+#include <image/KtxBundle.h>
 #include <utils/Path.h>
 
 using utils::Path;
@@ -67,6 +69,25 @@ IOUtil::img_data imageLoad(const char *path, int channels) {
 #endif
 }
 
+// A texture asset as loaded: the KTX bundle baked by tools/ktx_baker when one ships next to the image,
+// otherwise the image decoded by stb. The caller owns either.
+struct texture_data {
+    image::KtxBundle *ktx;
+    img_data image;
+};
+
+Path getBakedTexturePath(const utils::Path &path) {
+    return Path(path.getPath() + ".ktx");
+}
+
+texture_data textureLoad(const utils::Path &path, int channels) {
+    std::vector<unsigned char> baked = loadBinaryAsset(getBakedTexturePath(path));
+    if (!baked.empty()) {
+        return {new image::KtxBundle(baked.data(), baked.size()), {0, 0, 0, nullptr}};
+    }
+    return {nullptr, imageLoad(path.c_str(), channels)};
+}
+
 Path getTexturePath(const char *textureName) {
     Path path = std::string("textures/") + textureName;
 
@@ -76,6 +97,50 @@ Path getTexturePath(const char *textureName) {
     return path;
 }
 
+// Descriptor and byte range of an asset, for mapping it in place. On Android the asset must be stored
+// uncompressed in the APK. Returns -1 if it cannot be opened; the caller closes the descriptor.
+int openAssetDescriptor(const utils::Path &path, off_t &start, off_t &length) {
+#ifdef USE_SDL
+    int fd = open(path.c_str(), O_RDONLY);
+    start = 0;
+    length = fd < 0 ? 0 : lseek(fd, 0, SEEK_END);
+    return fd;
+#else
+    AAsset *asset = AAssetManager_open(((AndroidContext *) getContext())->assetManager, path.c_str(),
+                                       AASSET_MODE_UNKNOWN);
+    if (asset == nullptr) {
+        return -1;
+    }
+    int fd = AAsset_openFileDescriptor(asset, &start, &length);
+    AAsset_close(asset);
+    LOGI("open asset descriptor: %s %d", path.c_str(), fd);
+    return fd;
+#endif
+}
+
+bool assetExists(const utils::Path &path) {
+#ifdef USE_SDL
+    return path.exists();
+#else
+    AAsset *asset = AAssetManager_open(((AndroidContext *) getContext())->assetManager, path.c_str(),
+                                       AASSET_MODE_UNKNOWN);
+    if (asset == nullptr) {
+        return false;
+    }
+    AAsset_close(asset);
+    return true;
+#endif
+}
+
+Path getDataPath(const char *dataName) {
+    Path path = std::string("data/") + dataName;
+
+#ifdef USE_SDL
+    path = FilamentApp::getRootAssetsPath() + path;
+#endif
+    return path;
+}
+
 Path getMaterialPath(const char *materialName) {
     Path path = std::string("materials/") + materialName;
 
@@ -4,6 +4,7 @@
 #include "App.h"
 
 namespace tilepuzzles {
+struct ThreadPool;
 
 struct IRenderer {
   IRenderer() {
@@ -20,10 +21,15 @@ struct IRenderer {
 
   virtual void onMouseMove(const float2& dragPosition) = 0;
 
+  // Every position the pointer passed since the last frame, oldest first.
+  virtual void onMouseDrag(const float2* path, int count) = 0;
+
   virtual void initMesh() = 0;
 
   virtual void resize(int width, int height) = 0;
 
+  virtual void prepare(ResourceCache& resources, ThreadPool& pool) = 0;
+
   virtual void init(const App& app) = 0;
 
   virtual void destroy() = 0;
@@ -32,12 +38,20 @@ struct IRenderer {
 
   virtual void draw() = 0;
 
+  // Whether anything visible changed since the last call: geometry, material parameters or camera.
+  virtual bool takeViewChange() = 0;
+
   virtual void drawBorder() = 0;
 
   virtual void animate(double now) = 0;
 
   virtual void shuffle() = 0;
 
+  // Both search off the render thread and return -1 until the search for the current board is done.
+  virtual int solve() = 0;
+
+  virtual int hint() = 0;
+
   virtual bool isReadOnly() = 0;
 
   virtual void setReadOnly(bool readOnly) = 0;
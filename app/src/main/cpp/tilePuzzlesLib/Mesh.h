@@ -13,6 +13,7 @@
 
 #include "AnchorTile.h"
 #include "App.h"
+#include "BoardState.h"
 #include "TVertexBuffer.h"
 #include "Tile.h"
 #include "TileGroup.h"
@@ -75,9 +76,48 @@ struct Mesh {
   virtual void rotateTileGroup(TileGroup<T>& tileGroup, float angle) {
   }
 
+  virtual void poseTileGroup(const TileGroup<T>& tileGroup, float angle) {
+  }
+
+  virtual void turnTileGroup(const TileGroup<T>& tileGroup, int steps) {
+  }
+
   virtual void rollTileGroups(const TileGroup<T>& tileGroup, Direction dir) {
   }
 
+  // Copy of the board a search can run on away from the render thread.
+  std::vector<int> boardCells() const {
+    return std::vector<int>(board.cells.begin(), board.cells.end());
+  }
+
+  // Optimal move sequence from the given cells, in the mesh's own move encoding. Touches no mesh
+  // state besides the solver, so it may run on a worker while the board keeps changing.
+  virtual bool solve(const std::vector<int>& cells, std::vector<int>& moves) {
+    return false;
+  }
+
+  // Optimal move sequence from the current board.
+  bool solve(std::vector<int>& moves) {
+    return solve(boardCells(), moves);
+  }
+
+  virtual void applyMove(int move) {
+  }
+
+  // Tile number to move next towards the solution, -1 if there is none.
+  virtual int hint() {
+    std::vector<int> moves;
+    if (!solve(moves) || moves.empty()) {
+      return -1;
+    }
+    return moveTileNum(moves.front());
+  }
+
+  // Tile number that the given move picks up.
+  virtual int moveTileNum(int move) {
+    return tiles[board.tileAt(move)].tileNum;
+  }
+
   void logTiles() {
     std::for_each(std::begin(tiles), std::end(tiles), [](const T& t) {
       t.logVertices();
@@ -86,39 +126,81 @@ struct Mesh {
   }
 
   virtual T* tileAt(int row, int column) {
-    auto tileIter = std::find_if(tiles.begin(), tiles.end(), [row, column](const T& t) {
-      return row == t.gridCoord.x && column == t.gridCoord.y;
-    });
-    if (tileIter != tiles.end()) {
-      return &*tileIter;
-    } else {
+    if (!board.contains(row, column)) {
       return nullptr;
     }
+    return &tiles[board.tileAt(board.cell(row, column))];
   }
 
   virtual TileGroup<T>* tileGroupAt(int row, int column) {
-    auto tileIter =
-      std::find_if(tileGroupAnchors.begin(), tileGroupAnchors.end(),
-                   [row, column](const auto& t) { return row == t.gridCoord.x && column == t.gridCoord.y; });
-    if (tileIter != tileGroupAnchors.end()) {
-      return &*tileIter;
-    } else {
+    if (row < 0 || column < 0 || row >= groupRows || column >= groupColumns) {
       return nullptr;
     }
+    const int slot = tileGroupIndex[row * groupColumns + column];
+    return slot < 0 ? nullptr : &tileGroupAnchors[slot];
+  }
+
+  int slotOf(const T& tile) const {
+    return &tile - tiles.data();
+  }
+
+  // Logical grid coordinate of a tile. Tile::gridCoord is only refreshed by updateGeometry.
+  math::int2 gridCoordOf(const T& tile) const {
+    const int cell = board.cellOf(slotOf(tile));
+    return {board.row(cell), board.column(cell)};
+  }
+
+  // Rebuilds the vertices of the cells moved since the last call.
+  virtual void updateGeometry() {
+    board.flushDirty([this](int cell) { updateTileGeometry(tiles[board.tileAt(cell)], cell); });
+  }
+
+  virtual void updateTileGeometry(T& tile, int cell) {
+    const int row = board.row(cell);
+    const int column = board.column(cell);
+    tile.gridCoord = {row, column};
+    tile.topLeft = {GameUtil::LOW_X + column * tile.size.x, GameUtil::HIGH_Y - row * tile.size.y};
+    tile.updateVertices();
+  }
+
+  // Grid index of the draggable anchor groups; groups without a grid coordinate are skipped.
+  void indexTileGroups(int rows, int columns) {
+    groupRows = rows;
+    groupColumns = columns;
+    tileGroupIndex.assign(rows * columns, -1);
+    for (int i = 0; i < tileGroupAnchors.size(); ++i) {
+      const math::int2& coord = tileGroupAnchors[i].gridCoord;
+      if (coord.x >= 0 && coord.y >= 0 && coord.x < rows && coord.y < columns) {
+        tileGroupIndex[coord.x * columns + coord.y] = i;
+      }
+    }
   }
 
   virtual void setTileGroupZCoord(TileGroup<T>& tileGroup, float zCoord) {
   }
 
+  virtual void setTileGroupDragged(TileGroup<T>& tileGroup, bool dragged) {
+  }
+
+  // Tiles rest on the cells of the board, so the cell under the point names the tile.
   virtual T* hitTest(const math::float3& clipCoord) {
-    auto tileIter = std::find_if(tiles.begin(), tiles.end(), [&clipCoord](const T& t) {
-      return t.onClick({clipCoord.x, clipCoord.y});
-    });
-    if (tileIter != tiles.end()) {
-      return &*tileIter;
-    } else {
-      return nullptr;
+    updateGeometry();
+    const int cell = cellAt({clipCoord.x, clipCoord.y});
+    return cell < 0 ? nullptr : &tiles[board.tileAt(cell)];
+  }
+
+  // Cell of the square grid under the point, edges included; -1 off the board.
+  virtual int cellAt(const math::float2& point) const {
+    if (tiles.empty()) {
+      return -1;
+    }
+    const Size& size = tiles[0].size;
+    const float column = (point.x - GameUtil::LOW_X) / size.x;
+    const float row = (GameUtil::HIGH_Y - point.y) / size.y;
+    if (column < 0 || row < 0 || column > board.columns || row > board.rows) {
+      return -1;
     }
+    return board.cell(std::min(int(row), board.rows - 1), std::min(int(column), board.columns - 1));
   }
 
   virtual TileGroup<T>* hitTestAnchor(const math::float3& clipCoord) {
@@ -156,21 +238,40 @@ struct Mesh {
         const std::string tileId = string("tile") + to_string(r) + to_string(c);
         T tile(tileId, topLeft, size, &vertexBuffer->get(t), &vertexBuffer->getIndex(t), t, texWidth,
                indexOffset, {r, c}, t + 1, GameUtil::TILE_DEPTH);
+        tile.dirtyRange = &vertexBuffer->dirty;
         tiles.push_back(tile);
         ++t;
         indexOffset += 4;
       }
     }
+    board.init(dim, dim);
   }
 
   virtual void shuffle() {
-    GameUtil::shuffle<T>(tiles);
+    for (int i = board.size() - 1; i >= 1; --i) {
+      board.swapCells(i, GameUtil::trand(0, i));
+    }
   }
 
   bool hasBorder() {
     return configMgr.config["border"] != nullptr;
   }
 
+  // "render": {"instanced": true} in the puzzle config draws the tiles from per tile instance records.
+  bool renderInstanced() {
+    return renderOption("instanced");
+  }
+
+  // "render": {"gpuDrag": true} turns a dragged tile group in the vertex shader instead of on the CPU.
+  bool renderGpuDrag() {
+    return renderOption("gpuDrag");
+  }
+
+  bool renderOption(const char* name) {
+    auto renderConfig = configMgr.config["render"];
+    return renderConfig != nullptr && renderConfig[name] != nullptr && renderConfig[name].get<bool>();
+  }
+
   virtual void initBorder() {
     auto border = configMgr.config["border"];
     if (border != nullptr) {
@@ -218,25 +319,23 @@ struct Mesh {
     }
   }
 
-  TileGroup<T> nearestAnchorGroup(const math::float2& point) {
-    auto init = TileGroup<T>({100., 100.}, std::vector<T>(), 0, {0, 0});
-    auto res =
-      std::reduce(tileGroupAnchors.begin(), tileGroupAnchors.end(), init, [&point, this](auto a, auto b) {
-        math::float2 pointa = a.anchorPoint;
-        math::float2 pointb = b.anchorPoint;
-        float adist = GeoUtil::tdist({point.x, point.y, 0.}, {pointa.x, pointa.y, 0.});
-        float bdist = GeoUtil::tdist({point.x, point.y, 0.}, {pointb.x, pointb.y, 0.});
-        return adist < bdist ? a : b;
-      });
-    return res;
+  TileGroup<T>* nearestAnchorGroup(const math::float2& point) {
+    TileGroup<T>* nearest = nullptr;
+    float nearestDist = 0.F;
+    for (auto& group : tileGroupAnchors) {
+      const math::float2 anchor = group.anchorPoint;
+      const float dist = GeoUtil::tdist({point.x, point.y, 0.}, {anchor.x, anchor.y, 0.});
+      if (!nearest || dist < nearestDist) {
+        nearest = &group;
+        nearestDist = dist;
+      }
+    }
+    return nearest;
   }
 
   virtual void processAnchorGroups() {
   }
 
-  virtual void orderAnchorGroups() {
-  }
-
   virtual void collectAnchors() {
   }
 
@@ -254,6 +353,11 @@ struct Mesh {
   std::vector<AnchorTile> anchorTiles;
   std::vector<TileGroup<T>> tileGroupAnchors;
 
+  BoardState board;
+  std::vector<int> tileGroupIndex;
+  int groupRows = 0;
+  int groupColumns = 0;
+
 #ifdef USE_SDL
   Logger L;
 #endif
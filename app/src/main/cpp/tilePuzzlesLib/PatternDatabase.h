@@ -0,0 +1,196 @@
+#ifndef _PATTERN_DATABASE_H_
+#define _PATTERN_DATABASE_H_
+
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Disjoint additive pattern databases for the sliding puzzle, mapped read-only from a file written by
+// tools/pdb_builder. Each pattern is a set of tile slots; its table holds, for every placement of those
+// tiles, the number of pattern tile moves needed to bring them home. Pattern values add up to an
+// admissible heuristic because no move is counted by two patterns.
+//
+// File layout: PdbHeader, PdbPattern[patternCount], then one byte per rank for each table, each table
+// starting on a page boundary.
+struct PdbHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t dim;
+  uint32_t patternCount;
+};
+
+struct PdbPattern {
+  uint32_t tileCount;
+  uint8_t tiles[28];
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct PatternDatabase {
+  ~PatternDatabase() {
+    close();
+  }
+
+  bool open(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    const bool res = fstat(fd, &st) == 0 && map(fd, 0, st.st_size);
+    ::close(fd);
+    return res;
+  }
+
+  // Maps length bytes at offset of fd, e.g. an uncompressed APK asset. The descriptor may be closed after.
+  bool map(int fd, off_t offset, size_t length) {
+    close();
+    const off_t pageOffset = offset % sysconf(_SC_PAGE_SIZE);
+    void* addr = mmap(nullptr, length + pageOffset, PROT_READ, MAP_SHARED, fd, offset - pageOffset);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    mapping = addr;
+    mappingSize = length + pageOffset;
+    if (!attach((const uint8_t*)addr + pageOffset, length)) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  bool attach(const uint8_t* data, size_t length) {
+    if (length < sizeof(PdbHeader)) {
+      return false;
+    }
+    const PdbHeader* header = (const PdbHeader*)data;
+    if (memcmp(header->magic, MAGIC, 4) != 0 || header->version != VERSION || header->dim > MAX_DIM ||
+        length < sizeof(PdbHeader) + header->patternCount * sizeof(PdbPattern)) {
+      return false;
+    }
+    dim = header->dim;
+    const int size = dim * dim;
+    const PdbPattern* pattern = (const PdbPattern*)(data + sizeof(PdbHeader));
+    patternOf.fill(-1);
+    for (int p = 0; p < header->patternCount; ++p, ++pattern) {
+      if (pattern->tileCount > sizeof(pattern->tiles) ||
+          pattern->size != rankCount(pattern->tileCount, size) ||
+          pattern->offset + pattern->size > length) {
+        return false;
+      }
+      Pattern pat;
+      pat.tiles.assign(pattern->tiles, pattern->tiles + pattern->tileCount);
+      pat.table = data + pattern->offset;
+      for (int tile : pat.tiles) {
+        if (tile >= size - 1 || patternOf[tile] >= 0) {
+          return false;
+        }
+        patternOf[tile] = patterns.size();
+      }
+      patterns.push_back(pat);
+    }
+    for (int tile = 0; tile < size - 1; ++tile) {
+      if (patternOf[tile] < 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void close() {
+    if (mapping) {
+      munmap(mapping, mappingSize);
+      mapping = nullptr;
+      mappingSize = 0;
+    }
+    patterns.clear();
+    dim = 0;
+  }
+
+  bool isOpen() const {
+    return !patterns.empty();
+  }
+
+  // positions: cell of every tile slot.
+  int value(int pattern, const uint8_t* positions) const {
+    const Pattern& pat = patterns[pattern];
+    uint8_t cells[MAX_CELLS];
+    for (int i = 0; i < pat.tiles.size(); ++i) {
+      cells[i] = positions[pat.tiles[i]];
+    }
+    return pat.table[rank(cells, pat.tiles.size(), dim * dim)];
+  }
+
+  int heuristic(const uint8_t* positions) const {
+    int h = 0;
+    for (int p = 0; p < patterns.size(); ++p) {
+      h += value(p, positions);
+    }
+    return h;
+  }
+
+  // Perfect hash of count distinct cells out of size: a Lehmer code in mixed radix size, size - 1, ...
+  static uint64_t rank(const uint8_t* cells, int count, int size) {
+    uint64_t res = 0;
+    uint64_t used = 0;
+    for (int i = 0; i < count; ++i) {
+      const uint64_t below = used & ((1ULL << cells[i]) - 1);
+      res = res * (size - i) + cells[i] - __builtin_popcountll(below);
+      used |= 1ULL << cells[i];
+    }
+    return res;
+  }
+
+  static void unrank(uint64_t rank, int count, int size, uint8_t* cells) {
+    int digits[MAX_CELLS];
+    for (int i = count - 1; i >= 0; --i) {
+      digits[i] = rank % (size - i);
+      rank /= size - i;
+    }
+    uint64_t used = 0;
+    for (int i = 0; i < count; ++i) {
+      int cell = 0;
+      for (int free = digits[i];; ++cell) {
+        if (!(used & (1ULL << cell)) && free-- == 0) {
+          break;
+        }
+      }
+      cells[i] = cell;
+      used |= 1ULL << cell;
+    }
+  }
+
+  static uint64_t rankCount(int count, int size) {
+    uint64_t res = 1;
+    for (int i = 0; i < count; ++i) {
+      res *= size - i;
+    }
+    return res;
+  }
+
+  struct Pattern {
+    std::vector<uint8_t> tiles;
+    const uint8_t* table = nullptr;
+  };
+
+  static constexpr const char* MAGIC = "TPDB";
+  static constexpr uint32_t VERSION = 1;
+  static constexpr int MAX_DIM = 8;
+  static constexpr int MAX_CELLS = MAX_DIM * MAX_DIM;
+
+  int dim = 0;
+  std::vector<Pattern> patterns;
+  std::array<int8_t, MAX_CELLS> patternOf;
+  void* mapping = nullptr;
+  size_t mappingSize = 0;
+};
+
+} // namespace tilepuzzles
+#endif
@@ -0,0 +1,140 @@
+#ifndef _PATTERN_DATABASE_BUILDER_H_
+#define _PATTERN_DATABASE_BUILDER_H_
+
+#include "PatternDatabase.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Offline generation of the tables read by PatternDatabase.
+struct PatternDatabaseBuilder {
+  // Splits the tile slots 0..dim*dim-2 into consecutive patterns, e.g. {6, 6, 3} for 4x4.
+  static std::vector<std::vector<int>> partition(int dim, const std::vector<int>& sizes) {
+    std::vector<std::vector<int>> patterns;
+    int tile = 0;
+    for (int count : sizes) {
+      std::vector<int> pattern;
+      for (int i = 0; i < count; ++i) {
+        pattern.push_back(tile++);
+      }
+      patterns.push_back(pattern);
+    }
+    return tile == dim * dim - 1 ? patterns : std::vector<std::vector<int>>();
+  }
+
+  // Breadth first search backwards from the goal over (pattern tile cells, blank cell). Moving the blank
+  // through a non pattern cell is free, sliding a pattern tile costs one, so layers are expanded to their
+  // zero cost closure before the next one is started. The table keeps the cheapest cost over blank cells.
+  static std::vector<uint8_t> build(int dim, const std::vector<int>& tiles) {
+    const int size = dim * dim;
+    const int count = tiles.size();
+    const uint64_t ranks = PatternDatabase::rankCount(count, size);
+    const uint64_t states = ranks * size;
+    std::vector<uint8_t> table(ranks, UNSET);
+    std::vector<uint64_t> visited((states + 63) / 64);
+    std::vector<uint64_t> next((states + 63) / 64);
+    std::vector<uint64_t> stack;
+
+    uint8_t cells[PatternDatabase::MAX_CELLS];
+    for (int i = 0; i < count; ++i) {
+      cells[i] = tiles[i];
+    }
+    const uint64_t goal = PatternDatabase::rank(cells, count, size) * size + size - 1;
+    next[goal / 64] |= 1ULL << (goal % 64);
+
+    for (int depth = 0; depth < UNSET; ++depth) {
+      for (uint64_t w = 0; w < next.size(); ++w) {
+        uint64_t bits = next[w] & ~visited[w];
+        next[w] = 0;
+        visited[w] |= bits;
+        for (; bits; bits &= bits - 1) {
+          stack.push_back(w * 64 + __builtin_ctzll(bits));
+        }
+      }
+      if (stack.empty()) {
+        break;
+      }
+      while (!stack.empty()) {
+        const uint64_t state = stack.back();
+        stack.pop_back();
+        const uint64_t rank = state / size;
+        const int blank = state % size;
+        if (table[rank] == UNSET) {
+          table[rank] = depth;
+        }
+        PatternDatabase::unrank(rank, count, size, cells);
+        const int neighbors[] = {blank >= dim ? blank - dim : -1, blank < size - dim ? blank + dim : -1,
+                                 blank % dim ? blank - 1 : -1, blank % dim < dim - 1 ? blank + 1 : -1};
+        for (int to : neighbors) {
+          if (to < 0) {
+            continue;
+          }
+          int tile = 0;
+          while (tile < count && cells[tile] != to) {
+            ++tile;
+          }
+          if (tile < count) {
+            cells[tile] = blank;
+            const uint64_t moved = PatternDatabase::rank(cells, count, size) * size + to;
+            cells[tile] = to;
+            if (!(visited[moved / 64] & (1ULL << (moved % 64)))) {
+              next[moved / 64] |= 1ULL << (moved % 64);
+            }
+          } else {
+            const uint64_t moved = rank * size + to;
+            if (!(visited[moved / 64] & (1ULL << (moved % 64)))) {
+              visited[moved / 64] |= 1ULL << (moved % 64);
+              stack.push_back(moved);
+            }
+          }
+        }
+      }
+    }
+    return table;
+  }
+
+  static bool write(const std::string& path, int dim, const std::vector<std::vector<int>>& patterns,
+                    const std::vector<std::vector<uint8_t>>& tables) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+      return false;
+    }
+    PdbHeader header = {};
+    memcpy(header.magic, PatternDatabase::MAGIC, 4);
+    header.version = PatternDatabase::VERSION;
+    header.dim = dim;
+    header.patternCount = patterns.size();
+    bool res = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    uint64_t offset = align(sizeof(PdbHeader) + patterns.size() * sizeof(PdbPattern));
+    for (int p = 0; p < patterns.size(); ++p) {
+      PdbPattern entry = {};
+      entry.tileCount = patterns[p].size();
+      std::copy(patterns[p].begin(), patterns[p].end(), entry.tiles);
+      entry.offset = offset;
+      entry.size = tables[p].size();
+      res = res && fwrite(&entry, sizeof(entry), 1, file) == 1;
+      offset = align(offset + entry.size);
+    }
+    for (int p = 0; p < tables.size(); ++p) {
+      const std::vector<uint8_t> padding(align(ftell(file)) - ftell(file));
+      res = res && fwrite(padding.data(), 1, padding.size(), file) == padding.size();
+      res = res && fwrite(tables[p].data(), 1, tables[p].size(), file) == tables[p].size();
+    }
+    return fclose(file) == 0 && res;
+  }
+
+  static uint64_t align(uint64_t offset) {
+    return (offset + PAGE - 1) / PAGE * PAGE;
+  }
+
+  static constexpr uint8_t UNSET = 0xFF;
+  static constexpr uint64_t PAGE = 4096;
+};
+
+} // namespace tilepuzzles
+#endif
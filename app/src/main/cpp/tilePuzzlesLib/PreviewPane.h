@@ -0,0 +1,206 @@
+#ifndef _PREVIEW_PANE_H_
+#define _PREVIEW_PANE_H_
+
+#include "App.h"
+#include "IRenderer.h"
+#include "ResourceCache.h"
+
+#include <filament/Camera.h>
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/Material.h>
+#include <filament/MaterialInstance.h>
+#include <filament/RenderTarget.h>
+#include <filament/RenderableManager.h>
+#include <filament/Renderer.h>
+#include <filament/Scene.h>
+#include <filament/Texture.h>
+#include <filament/TextureSampler.h>
+#include <filament/VertexBuffer.h>
+#include <filament/View.h>
+#include <utils/EntityManager.h>
+
+#include <functional>
+#include <memory>
+
+using namespace filament;
+using utils::Entity;
+using utils::EntityManager;
+
+namespace tilepuzzles {
+
+// The read-only board drawn into a texture and shown as a single quad, in a view without post processing.
+// The board renderer only lives for a capture: it is built, rendered standalone into the target and destroyed,
+// so the preview costs one textured quad per frame and no mesh. Captures again when the viewport size
+// changes, or on recapture() after a config change.
+struct PreviewPane {
+  using Factory = std::function<std::shared_ptr<IRenderer>()>;
+
+  explicit PreviewPane(Factory factory) : factory(factory) {
+  }
+
+  // app carries the preview's viewport layout, used to build each capture's board.
+  void init(const App& app) {
+    this->app = app;
+    engine = app.engine;
+    scene = engine->createScene();
+    EntityManager::get().create(1, &cameraEntity);
+    camera = engine->createCamera(cameraEntity);
+    camera->setProjection(Camera::Projection::ORTHO, -1., 1., -1., 1., -1., 1.);
+    view = engine->createView();
+    view->setPostProcessingEnabled(false);
+    view->setCamera(camera);
+    view->setScene(scene);
+
+    static const Vertex QUAD_VERTICES[4] = {
+      {{-1, -1, 0}, {0, 0, 0}, {0, 0}},
+      {{1, -1, 0}, {0, 0, 0}, {1, 0}},
+      {{-1, 1, 0}, {0, 0, 0}, {0, 1}},
+      {{1, 1, 0}, {0, 0, 0}, {1, 1}},
+    };
+    static constexpr uint16_t QUAD_INDICES[6] = {
+      0, 1, 2, 3, 2, 1,
+    };
+    vb = VertexBuffer::Builder()
+           .vertexCount(4)
+           .bufferCount(1)
+           .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, sizeof(Vertex))
+           .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT2, 24, sizeof(Vertex))
+           .build(*engine);
+    vb->setBufferAt(*engine, 0, VertexBuffer::BufferDescriptor(QUAD_VERTICES, sizeof(Vertex) * 4, nullptr));
+    ib = IndexBuffer::Builder().indexCount(6).bufferType(IndexBuffer::IndexType::USHORT).build(*engine);
+    ib->setBuffer(*engine, IndexBuffer::BufferDescriptor(QUAD_INDICES, sizeof(uint16_t) * 6, nullptr));
+    material = app.resources->acquireMaterial(IOUtil::getMaterialPath(FILAMAT_FILE_OPAQUE.data()));
+    matInstance = material->createInstance();
+    renderable = EntityManager::get().create();
+    RenderableManager::Builder(1)
+      .boundingBox({{-1, -1, -1}, {1, 1, 1}})
+      .material(0, matInstance)
+      .geometry(0, RenderableManager::PrimitiveType::TRIANGLES, vb, ib, 0, 6)
+      .receiveShadows(false)
+      .castShadows(false)
+      .culling(false)
+      .build(*engine, renderable);
+  }
+
+  // Same viewport as a read-only TRenderer.
+  void resize(int width, int height) {
+    winWidth = width;
+    winHeight = height;
+    if (width <= 0 || height <= 0) {
+      return;
+    }
+    view->setViewport({0, 0, uint32_t(width / 2 - 5), uint32_t(height)});
+    const Viewport& viewport = view->getViewport();
+    if (!target || viewport.width != color->getWidth() || viewport.height != color->getHeight()) {
+      capture();
+    }
+  }
+
+  void recapture() {
+    if (target) {
+      capture();
+    }
+  }
+
+  void capture() {
+    const Viewport& viewport = view->getViewport();
+    destroyTarget();
+    color = Texture::Builder()
+              .width(viewport.width)
+              .height(viewport.height)
+              .levels(1)
+              .usage(Texture::Usage::COLOR_ATTACHMENT | Texture::Usage::SAMPLEABLE)
+              .format(Texture::InternalFormat::RGBA8)
+              .build(*engine);
+    depth = Texture::Builder()
+              .width(viewport.width)
+              .height(viewport.height)
+              .levels(1)
+              .usage(Texture::Usage::DEPTH_ATTACHMENT)
+              .format(Texture::InternalFormat::DEPTH24)
+              .build(*engine);
+    target = RenderTarget::Builder()
+               .texture(RenderTarget::AttachmentPoint::COLOR, color)
+               .texture(RenderTarget::AttachmentPoint::DEPTH, depth)
+               .build(*engine);
+
+    std::shared_ptr<IRenderer> board = factory();
+    board->setReadOnly(true);
+    board->init(app);
+    board->draw();
+    board->resize(winWidth, winHeight);
+    View* boardView = board->getView();
+    boardView->setViewport({0, 0, viewport.width, viewport.height});
+    boardView->setRenderTarget(target);
+    app.filaRenderer->renderStandaloneView(boardView);
+    board->destroy();
+
+    TextureSampler sampler(TextureSampler::MinFilter::LINEAR, TextureSampler::MagFilter::LINEAR);
+    matInstance->setParameter("albedo", color, sampler);
+    scene->addEntity(renderable);
+    viewChanged = true;
+  }
+
+  bool isCaptured() const {
+    return target != nullptr;
+  }
+
+  bool takeViewChange() {
+    const bool changed = viewChanged;
+    viewChanged = false;
+    return changed;
+  }
+
+  View* getView() {
+    return view;
+  }
+
+  void destroyTarget() {
+    if (target) {
+      scene->remove(renderable);
+      engine->destroy(target);
+      engine->destroy(color);
+      engine->destroy(depth);
+      target = nullptr;
+    }
+  }
+
+  void destroy() {
+    destroyTarget();
+    engine->destroy(renderable);
+    engine->destroy(matInstance);
+    app.resources->release(material);
+    engine->destroy(vb);
+    engine->destroy(ib);
+    engine->destroy(view);
+    engine->destroy(scene);
+    engine->destroyCameraComponent(cameraEntity);
+    EntityManager::get().destroy(cameraEntity);
+    EntityManager::get().destroy(renderable);
+  }
+
+  Factory factory;
+  App app;
+  Engine* engine = nullptr;
+  Scene* scene = nullptr;
+  View* view = nullptr;
+  Camera* camera = nullptr;
+  Entity cameraEntity;
+  Entity renderable;
+  VertexBuffer* vb = nullptr;
+  IndexBuffer* ib = nullptr;
+  Material* material = nullptr;
+  MaterialInstance* matInstance = nullptr;
+  Texture* color = nullptr;
+  Texture* depth = nullptr;
+  RenderTarget* target = nullptr;
+  int winWidth = 0;
+  int winHeight = 0;
+  bool viewChanged = false;
+
+  static constexpr std::string_view FILAMAT_FILE_OPAQUE = "bakedTextureOpaque.filamat";
+};
+
+} // namespace tilepuzzles
+#endif
@@ -0,0 +1,206 @@
+#ifndef _RESOURCE_CACHE_H_
+#define _RESOURCE_CACHE_H_
+
+#ifdef USE_SDL
+#include "GLogger.h"
+#else
+#include "android_debug.h"
+#endif
+
+#include "IOUtil.h"
+#include "ThreadPool.h"
+
+#include <filament/Engine.h>
+#include <filament/Material.h>
+#include <filament/Texture.h>
+#include <image/KtxUtility.h>
+#include <stb_image.h>
+
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace filament;
+
+namespace tilepuzzles {
+
+// Materials and textures shared by every renderer of an App, keyed by asset path. The first acquire reads
+// and uploads the asset, later ones only count a reference; the last release destroys the Filament object.
+// prefetch*() may run before the engine exists and off the main thread: they read and decode on a pool, and
+// the acquire on the engine thread only builds the Filament object from the result. Acquire and release stay
+// on the engine thread.
+struct ResourceCache {
+  template <typename R> struct Entry {
+    R* resource = nullptr;
+    int refs = 0;
+    size_t bytes = 0;
+  };
+
+  explicit ResourceCache(Engine* engine) : engine(engine) {
+  }
+
+  ~ResourceCache() {
+    for (auto& pending : pendingTextures) {
+      IOUtil::texture_data data = pending.second.get();
+      delete data.ktx;
+      stbi_image_free(data.image.data);
+    }
+    for (auto& entry : materials) {
+      engine->destroy(entry.second.resource);
+    }
+    for (auto& entry : textures) {
+      engine->destroy(entry.second.resource);
+    }
+  }
+
+  void prefetchMaterial(const Path& path, ThreadPool& pool) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!materials.count(path.getPath()) && !pendingMaterials.count(path.getPath())) {
+      pendingMaterials[path.getPath()] = submit(pool, [path] { return IOUtil::loadBinaryAsset(path); });
+    }
+  }
+
+  void prefetchTexture(const Path& path, ThreadPool& pool) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!textures.count(path.getPath()) && !pendingTextures.count(path.getPath())) {
+      pendingTextures[path.getPath()] = submit(pool, [path] { return IOUtil::textureLoad(path, 4); });
+    }
+  }
+
+  Material* acquireMaterial(const Path& path) {
+    Entry<Material>& entry = materials[path.getPath()];
+    ++requests;
+    if (!entry.resource) {
+      const auto start = std::chrono::steady_clock::now();
+      std::vector<unsigned char> mat = take(pendingMaterials, path, [&path] { return IOUtil::loadBinaryAsset(path); });
+      entry.resource = Material::Builder().package(mat.data(), mat.size()).build(*engine);
+      loadTime += std::chrono::steady_clock::now() - start;
+      ++loads;
+    }
+    ++entry.refs;
+    return entry.resource;
+  }
+
+  // The baked KTX with its mip chain when the device samples its format, else an RGBA8 texture of the
+  // decoded image, one level.
+  Texture* acquireTexture(const Path& path) {
+    Entry<Texture>& entry = textures[path.getPath()];
+    ++requests;
+    if (!entry.resource) {
+      const auto start = std::chrono::steady_clock::now();
+      IOUtil::texture_data data = take(pendingTextures, path, [&path] { return IOUtil::textureLoad(path, 4); });
+      if (data.ktx &&
+          !Texture::isTextureFormatSupported(*engine, image::ktx::toTextureFormat(data.ktx->getInfo()))) {
+        delete data.ktx;
+        data = {nullptr, IOUtil::imageLoad(path.c_str(), 4)};
+      }
+      if (data.ktx) {
+        entry.bytes = bakedSize(*data.ktx);
+        entry.resource = image::ktx::createTexture(engine, data.ktx, false);
+      } else {
+        const IOUtil::img_data& image = data.image;
+        entry.bytes = size_t(image.width * image.height * 4);
+        Texture::PixelBufferDescriptor buffer(image.data, entry.bytes, Texture::Format::RGBA, Texture::Type::UBYTE,
+                                              (Texture::PixelBufferDescriptor::Callback) & ::stbi_image_free);
+        entry.resource = Texture::Builder()
+                           .width(uint32_t(image.width))
+                           .height(uint32_t(image.height))
+                           .levels(1)
+                           .sampler(Texture::Sampler::SAMPLER_2D)
+                           .format(Texture::InternalFormat::RGBA8)
+                           .build(*engine);
+        entry.resource->setImage(*engine, 0, std::move(buffer));
+      }
+      loadTime += std::chrono::steady_clock::now() - start;
+      textureBytes += entry.bytes;
+      ++loads;
+    }
+    ++entry.refs;
+    requestedTextureBytes += entry.bytes;
+    return entry.resource;
+  }
+
+  void release(Material* material) {
+    release(materials, material);
+  }
+
+  void release(Texture* texture) {
+    release(textures, texture);
+  }
+
+  template <typename R> void release(std::map<std::string, Entry<R>>& entries, R* resource) {
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->second.resource == resource) {
+        if (--it->second.refs == 0) {
+          engine->destroy(resource);
+          textureBytes -= it->second.bytes;
+          entries.erase(it);
+        }
+        return;
+      }
+    }
+  }
+
+  static size_t bakedSize(const image::KtxBundle& ktx) {
+    size_t bytes = 0;
+    for (uint32_t level = 0; level < ktx.getNumMipLevels(); ++level) {
+      uint8_t* data;
+      uint32_t size;
+      ktx.getBlob({level, 0, 0}, &data, &size);
+      bytes += size;
+    }
+    return bytes;
+  }
+
+  template <typename F> static auto submit(ThreadPool& pool, F load) -> std::future<decltype(load())> {
+    auto task = std::make_shared<std::packaged_task<decltype(load())()>>(load);
+    pool.submit([task] { (*task)(); });
+    return task->get_future();
+  }
+
+  // The prefetched result for path, waiting for it if still running, or loaded here if never prefetched.
+  template <typename T, typename F> T take(std::map<std::string, std::future<T>>& pending, const Path& path, F load) {
+    std::future<T> result;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = pending.find(path.getPath());
+      if (it != pending.end()) {
+        result = std::move(it->second);
+        pending.erase(it);
+      }
+    }
+    return result.valid() ? result.get() : load();
+  }
+
+  // Loads against requests, and texture memory against what every renderer loading its own copy would use.
+  void report() const {
+    const double ms = std::chrono::duration<double, std::milli>(loadTime).count();
+#ifdef USE_SDL
+    L.info("resources requested:", requests, "loaded:", loads, "load ms:", ms, "texture bytes:", textureBytes,
+           "unshared:", requestedTextureBytes);
+#else
+    LOGI("resources requested: %d loaded: %d load ms: %.1f texture bytes: %zu unshared: %zu", requests, loads, ms,
+         textureBytes, requestedTextureBytes);
+#endif
+  }
+
+  Engine* engine;
+  std::map<std::string, Entry<Material>> materials;
+  std::map<std::string, Entry<Texture>> textures;
+  std::map<std::string, std::future<std::vector<unsigned char>>> pendingMaterials;
+  std::map<std::string, std::future<IOUtil::texture_data>> pendingTextures;
+  std::mutex mutex;
+  int requests = 0;
+  int loads = 0;
+  std::chrono::steady_clock::duration loadTime{0};
+  size_t textureBytes = 0;
+  size_t requestedTextureBytes = 0;
+#ifdef USE_SDL
+  constexpr static Logger L = Logger::getLogger();
+#endif
+};
+
+} // namespace tilepuzzles
+#endif
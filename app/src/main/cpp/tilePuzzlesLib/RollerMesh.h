@@ -5,6 +5,7 @@
 #include "GLogger.h"
 #endif
 #include "Mesh.h"
+#include "RollerSolver.h"
 #include "Tile.h"
 #include "enums.h"
 
@@ -19,23 +20,79 @@ struct RollerMesh : Mesh<TQuadVertexBuffer, Tile> {
   RollerMesh() {
   }
 
-  virtual void initTiles() {
-    Mesh::initTiles();
-    initTileBounds();
+  virtual void init(const std::string& jsonStr) {
+    Mesh::init(jsonStr);
+    // no solve or hint above RollerSolver::MAX_DIM
+    canSolve = solver.init(board.rows);
+  }
+
+  // Random rolls: a random permutation is unreachable half the time on odd boards. Rolled directly, since
+  // the solver's move encoding only covers its MAX_DIM.
+  virtual void shuffle() {
+    for (int i = 0; i < SHUFFLE_ROLLS * board.size(); ++i) {
+      const bool isColumn = GameUtil::coinFlip();
+      rollBoardLine(isColumn, GameUtil::trand(0, isColumn ? board.columns : board.rows),
+                    GameUtil::coinFlip() ? 1 : -1);
+    }
+  }
+
+  // Optimal up to 4x4 unless the search runs out of nodes, commutator based above.
+  using Mesh::solve;
+  virtual bool solve(const std::vector<int>& cells, std::vector<int>& moves) {
+    moves.clear();
+    if (!canSolve) {
+      return false;
+    }
+    if (board.rows <= MAX_OPTIMAL_DIM && solver.solve(cells, moves)) {
+      return true;
+    }
+    return solver.solveFast(cells, moves);
+  }
+
+  virtual void applyMove(int move) {
+    rollBoardLine(RollerSolver::isColumn(move), RollerSolver::lineOf(move), RollerSolver::stepOf(move));
+  }
+
+  void rollBoardLine(bool isColumn, int line, int step) {
+    if (isColumn) {
+      rollLine(board.cell(0, line), board.columns, board.rows, step);
+    } else {
+      rollLine(board.cell(line, 0), 1, board.columns, step);
+    }
+  }
+
+  // A move is a whole line; the hint is the first tile on it.
+  virtual int moveTileNum(int move) {
+    const int line = RollerSolver::lineOf(move);
+    const int cell = RollerSolver::isColumn(move) ? board.cell(0, line) : board.cell(line, 0);
+    return tiles[board.tileAt(cell)].tileNum;
   }
 
   virtual std::vector<Tile*> rollTiles(const Tile& tile, Direction dir) {
     auto rollerTiles = tilesToRoll(tile, dir);
-    const int dim = sqrt(tiles.size());
-    std::for_each(rollerTiles.begin(), rollerTiles.end(),
-                  [this, dir, dim](Tile* t) { rollTile(*t, dir, dim - 1); });
-
+    const math::int2 pick = gridCoordOf(tile);
+    switch (dir) {
+      case Direction::up:
+        rollLine(board.cell(0, pick.y), board.columns, board.rows, -1);
+        break;
+      case Direction::down:
+        rollLine(board.cell(0, pick.y), board.columns, board.rows, 1);
+        break;
+      case Direction::left:
+        rollLine(board.cell(pick.x, 0), 1, board.columns, -1);
+        break;
+      case Direction::right:
+        rollLine(board.cell(pick.x, 0), 1, board.columns, 1);
+        break;
+      default:
+        break;
+    }
     return rollerTiles;
   }
 
   std::vector<Tile*> tilesToRoll(const Tile& tilePick, Direction dir) {
-    const int pickRow = tilePick.gridCoord.x;
-    const int pickCol = tilePick.gridCoord.y;
+    const int pickRow = gridCoordOf(tilePick).x;
+    const int pickCol = gridCoordOf(tilePick).y;
     const int dim = sqrt(tiles.size());
     auto rollerTiles = std::vector<Tile*>();
     switch (dir) {
@@ -58,79 +115,29 @@ struct RollerMesh : Mesh<TQuadVertexBuffer, Tile> {
     }
   }
 
-  void rollTile(Tile& tile, Direction dir, int maxCoord) {
-    switch (dir) {
-      case Direction::up:
-        tile.topLeft.y += tile.size.y;
-        tile.gridCoord.x -= 1;
-        if (tile.gridCoord.x < 0) {          
-          tile.topLeft.y = low_y + tile.size.y;
-          tile.gridCoord.x = maxCoord;
-        }
-        break;
-      case Direction::down:
-        tile.topLeft.y -= tile.size.y;
-        tile.gridCoord.x += 1;
-        if (tile.gridCoord.x > maxCoord) {
-          tile.topLeft.y = high_y;
-          tile.gridCoord.x = 0;
-        }
-        break;
-      case Direction::left:
-        tile.topLeft[0] -= tile.size.x;
-        tile.gridCoord.y -= 1;
-        if (tile.gridCoord.y < 0) {
-          tile.topLeft.x = high_x - tile.size.x;
-          tile.gridCoord.y = maxCoord;
-        }
-        break;
-      case Direction::right:
-        tile.topLeft.x += tile.size.x;
-        tile.gridCoord.y += 1;
-        if (tile.gridCoord.y > maxCoord) {
-          tile.topLeft.x = low_x;
-          tile.gridCoord.y = 0;
-        }
-        break;
-      default:
-        break;
+  // Cyclically shifts the count cells starting at first, stride apart, by one cell towards +/-step.
+  void rollLine(int first, int stride, int count, int step) {
+    const int last = first + (count - 1) * stride;
+    if (step > 0) {
+      const int slot = board.tileAt(last);
+      for (int cell = last; cell != first; cell -= stride) {
+        board.place(cell, board.tileAt(cell - stride));
+      }
+      board.place(first, slot);
+    } else {
+      const int slot = board.tileAt(first);
+      for (int cell = first; cell != last; cell += stride) {
+        board.place(cell, board.tileAt(cell + stride));
+      }
+      board.place(last, slot);
     }
-    tile.updateVertices();
   }
 
-  void initTileBounds() {
-    low_x = low_y = std::numeric_limits<float>::max();
-    high_x = high_y = std::numeric_limits<float>::min();
-
-    std::for_each(tiles.begin(), tiles.end(), [this](const Tile& t) {
-      QuadVertices* iniQuad = t.iniQuadVertices;
-
-      low_x = std::min(low_x, (*iniQuad)[0].position.x);
-      low_x = std::min(low_x, (*iniQuad)[1].position.x);
-      low_x = std::min(low_x, (*iniQuad)[2].position.x);
-      low_x = std::min(low_x, (*iniQuad)[3].position.x);
-
-      high_x = std::max(high_x, (*iniQuad)[0].position.x);
-      high_x = std::max(high_x, (*iniQuad)[1].position.x);
-      high_x = std::max(high_x, (*iniQuad)[2].position.x);
-      high_x = std::max(high_x, (*iniQuad)[3].position.x);
-
-      low_y = std::min(low_y, (*iniQuad)[0].position.y);
-      low_y = std::min(low_y, (*iniQuad)[1].position.y);
-      low_y = std::min(low_y, (*iniQuad)[2].position.y);
-      low_y = std::min(low_y, (*iniQuad)[3].position.y);
-
-      high_y = std::max(high_y, (*iniQuad)[0].position.y);
-      high_y = std::max(high_y, (*iniQuad)[1].position.y);
-      high_y = std::max(high_y, (*iniQuad)[2].position.y);
-      high_y = std::max(high_y, (*iniQuad)[3].position.y);
-    });
-  }
+  static constexpr int MAX_OPTIMAL_DIM = 4;
+  static constexpr int SHUFFLE_ROLLS = 4;
 
-  float low_x;
-  float high_x;
-  float low_y;
-  float high_y;
+  RollerSolver solver;
+  bool canSolve = false;
 };
 
 } // namespace tilepuzzles
@@ -0,0 +1,404 @@
+#ifndef _ROLLER_SOLVER_H_
+#define _ROLLER_SOLVER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <stdint.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Solver for the roller puzzle, where a move rolls one row or column cyclically by one cell. A board is
+// given as cell -> tile slot (see BoardState) and the goal is the identity.
+// A move is encoded as line * 2 + (step > 0 ? 0 : 1), where rows are lines 0..dim-1 and columns start at
+// MAX_DIM; a positive step rolls a row right and a column down.
+//
+// solve() is optimal: IDA* with a toroidal displacement bound. A column roll changes the cyclic row
+// distance of dim tiles by at most one each, so vertical moves are at least max(ceil(sum / dim), max) of
+// the row distances, and likewise for horizontal moves and column distances. It gives up after
+// maxNodes, which only matters beyond 4x4.
+// solveFast() is not optimal but linear in the board size: it places the tiles one by one with 3-cycles.
+// The commutator R^k C^m R^-k C^-m of a row r and a column c cycles (r, c-k) -> (r, c) -> (r-m, c), and
+// any other three cells are brought into that L shape by at most two setup rolls that are undone after.
+struct RollerSolver {
+  // The board and the move encoding hold boards up to MAX_DIM; larger ones leave the solver empty, so every
+  // solve fails.
+  bool init(int dim) {
+    if (dim < 2 || dim > MAX_DIM) {
+      this->dim = size = 0;
+      return false;
+    }
+    this->dim = dim;
+    size = dim * dim;
+    return true;
+  }
+
+  // A roll is a dim-cycle, so on odd boards every reachable permutation is even.
+  static bool isSolvable(const std::vector<int>& cells, int dim) {
+    return dim % 2 == 0 || !isOdd(cells);
+  }
+
+  static bool isOdd(const std::vector<int>& cells) {
+    std::vector<bool> seen(cells.size());
+    int cycles = 0;
+    for (int i = 0; i < cells.size(); ++i) {
+      if (seen[i]) {
+        continue;
+      }
+      ++cycles;
+      for (int j = i; !seen[j]; j = cells[j]) {
+        seen[j] = true;
+      }
+    }
+    return (cells.size() - cycles) % 2 == 1;
+  }
+
+  static int encode(bool isColumn, int line, int step) {
+    return ((isColumn ? line + MAX_DIM : line) * 2 + (step > 0 ? 0 : 1));
+  }
+
+  static bool isColumn(int move) {
+    return move / 2 >= MAX_DIM;
+  }
+
+  static int lineOf(int move) {
+    return move / 2 % MAX_DIM;
+  }
+
+  static int stepOf(int move) {
+    return move % 2 ? -1 : 1;
+  }
+
+  static int inverse(int move) {
+    return move ^ 1;
+  }
+
+  bool solve(const std::vector<int>& cells, std::vector<int>& moves) {
+    moves.clear();
+    nodes = 0;
+    if (cells.size() != size || !isSolvable(cells, dim)) {
+      return false;
+    }
+    for (int cell = 0; cell < size; ++cell) {
+      board[cell] = cells[cell];
+    }
+    path.clear();
+    int bound = heuristic();
+    while (bound < MAX_BOUND && nodes < maxNodes) {
+      const int t = search(0, bound, -1, 0);
+      if (t == FOUND) {
+        moves = path;
+        return true;
+      }
+      bound = t;
+    }
+    return false;
+  }
+
+  bool solveFast(const std::vector<int>& cells, std::vector<int>& moves) {
+    moves.clear();
+    if (cells.size() != size || !isSolvable(cells, dim)) {
+      return false;
+    }
+    work = cells;
+    positions.resize(size);
+    for (int cell = 0; cell < size; ++cell) {
+      positions[work[cell]] = cell;
+    }
+    if (isOdd(work)) {
+      play(encode(false, 0, 1), moves);
+    }
+    for (int target = 0; target < size - 2; ++target) {
+      if (work[target] == target) {
+        continue;
+      }
+      const int from = positions[target];
+      // the third cell of the cycle: an unsolved L corner when there is one, otherwise the last cell
+      const int candidates[] = {row(target) * dim + column(from), row(from) * dim + column(target), size - 1,
+                                size - 2};
+      std::vector<int> best;
+      for (int setups = 1; setups <= 2 && best.empty(); ++setups) {
+        for (int other : candidates) {
+          if (other <= target || other == from) {
+            continue;
+          }
+          std::vector<int> sequence;
+          if (cycle(from, target, other, sequence, setups) &&
+              (best.empty() || sequence.size() < best.size())) {
+            best.swap(sequence);
+          }
+        }
+      }
+      for (int move : best) {
+        play(move, moves);
+      }
+    }
+    for (int cell = 0; cell < size; ++cell) {
+      if (work[cell] != cell) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Moves that send the tile on a to b, the tile on b to c and the tile on c to a, leaving the rest.
+  // Two setup rolls always suffice.
+  bool cycle(int a, int b, int c, std::vector<int>& sequence, int maxSetups = 2) const {
+    const std::array<int, 3> cells = {a, b, c};
+    int bestCost = commutator(cells, nullptr);
+    std::vector<int> bestSetups;
+    if (bestCost < 0) {
+      // only shifts of lines through the cells can change their shape
+      for (int first : setupsThrough(cells)) {
+        const std::array<int, 3> once = {shift(a, first), shift(b, first), shift(c, first)};
+        const int cost = commutator(once, nullptr);
+        if (cost >= 0 && (bestCost < 0 || cost + 2 * setupCost(first) < bestCost)) {
+          bestCost = cost + 2 * setupCost(first);
+          bestSetups = {first};
+        }
+      }
+    }
+    if (bestCost < 0 && maxSetups >= 2) {
+      for (int first : setupsThrough(cells)) {
+        const std::array<int, 3> once = {shift(a, first), shift(b, first), shift(c, first)};
+        for (int second : setupsThrough(once)) {
+          const std::array<int, 3> twice = {shift(once[0], second), shift(once[1], second),
+                                            shift(once[2], second)};
+          const int cost = commutator(twice, nullptr);
+          const int total = cost + 2 * (setupCost(first) + setupCost(second));
+          if (cost >= 0 && (bestCost < 0 || total < bestCost)) {
+            bestCost = total;
+            bestSetups = {first, second};
+          }
+        }
+      }
+    }
+    if (bestCost < 0) {
+      return false;
+    }
+    std::array<int, 3> shape = cells;
+    for (int setup : bestSetups) {
+      for (int& cell : shape) {
+        cell = shift(cell, setup);
+      }
+    }
+    sequence.clear();
+    for (int setup : bestSetups) {
+      roll(setup / (dim - 1) >= dim, setup / (dim - 1) % dim, setup % (dim - 1) + 1, sequence);
+    }
+    commutator(shape, &sequence);
+    for (int i = bestSetups.size() - 1; i >= 0; --i) {
+      const int line = bestSetups[i] / (dim - 1);
+      roll(line >= dim, line % dim, -(bestSetups[i] % (dim - 1) + 1), sequence);
+    }
+    return true;
+  }
+
+  // Cells (A, I, B) with A on the row of I and B on its column cycle A -> I -> B by R^k C^m R^-k C^-m,
+  // and A -> B -> I by its inverse C^m R^k C^-m R^-k. Returns the move count, or -1 for other shapes;
+  // the moves are appended to sequence when given.
+  int commutator(const std::array<int, 3>& cells, std::vector<int>* sequence) const {
+    for (int i = 0; i < 3; ++i) {
+      const int first = cells[i];
+      const int second = cells[(i + 1) % 3];
+      const int third = cells[(i + 2) % 3];
+      if (isCorner(first, second, third)) {
+        // first -> second(I) -> third
+        const int k = column(second) - column(first);
+        const int m = row(second) - row(third);
+        if (sequence) {
+          roll(false, row(second), k, *sequence);
+          roll(true, column(second), m, *sequence);
+          roll(false, row(second), -k, *sequence);
+          roll(true, column(second), -m, *sequence);
+        }
+        return 2 * (rollCost(k) + rollCost(m));
+      }
+      if (isCorner(first, third, second)) {
+        // first -> second -> third(I), the inverse of first -> third -> second
+        const int k = column(third) - column(first);
+        const int m = row(third) - row(second);
+        if (sequence) {
+          roll(true, column(third), m, *sequence);
+          roll(false, row(third), k, *sequence);
+          roll(true, column(third), -m, *sequence);
+          roll(false, row(third), -k, *sequence);
+        }
+        return 2 * (rollCost(k) + rollCost(m));
+      }
+    }
+    return -1;
+  }
+
+  // a on the row of corner, b on its column.
+  bool isCorner(int a, int corner, int b) const {
+    return row(a) == row(corner) && column(a) != column(corner) && column(b) == column(corner) &&
+           row(b) != row(corner);
+  }
+
+  // Setups are whole line shifts numbered by line and amount 1..dim-1, rows first.
+  int shift(int cell, int setup) const {
+    const int line = setup / (dim - 1);
+    const int amount = setup % (dim - 1) + 1;
+    if (line < dim) {
+      return row(cell) == line ? row(cell) * dim + (column(cell) + amount) % dim : cell;
+    }
+    return column(cell) == line - dim ? (row(cell) + amount) % dim * dim + column(cell) : cell;
+  }
+
+  int setupCost(int setup) const {
+    return rollCost(setup % (dim - 1) + 1);
+  }
+
+  std::vector<int> setupsThrough(const std::array<int, 3>& cells) const {
+    std::vector<int> lines;
+    for (int cell : cells) {
+      for (int line : {row(cell), dim + column(cell)}) {
+        if (std::find(lines.begin(), lines.end(), line) == lines.end()) {
+          lines.push_back(line);
+        }
+      }
+    }
+    std::vector<int> setups;
+    for (int line : lines) {
+      for (int amount = 0; amount < dim - 1; ++amount) {
+        setups.push_back(line * (dim - 1) + amount);
+      }
+    }
+    return setups;
+  }
+
+  int rollCost(int amount) const {
+    amount = ((amount % dim) + dim) % dim;
+    return amount < dim - amount ? amount : dim - amount;
+  }
+
+  // Unit moves for a shift by amount, taking the shorter way round.
+  void roll(bool isColumn, int line, int amount, std::vector<int>& sequence) const {
+    amount = ((amount % dim) + dim) % dim;
+    const int step = amount > dim / 2 ? -1 : 1;
+    const int count = step > 0 ? amount : dim - amount;
+    for (int i = 0; i < count; ++i) {
+      sequence.push_back(encode(isColumn, line, step));
+    }
+  }
+
+  void play(int move, std::vector<int>& moves) {
+    apply(move, work.data());
+    for (int i = 0; i < dim; ++i) {
+      const int cell = isColumn(move) ? i * dim + lineOf(move) : lineOf(move) * dim + i;
+      positions[work[cell]] = cell;
+    }
+    moves.push_back(move);
+  }
+
+  template <typename C>
+  void apply(int move, C* cells) const {
+    const int line = lineOf(move);
+    const int first = isColumn(move) ? line : line * dim;
+    const int stride = isColumn(move) ? dim : 1;
+    const int last = first + (dim - 1) * stride;
+    if (stepOf(move) > 0) {
+      const C tile = cells[last];
+      for (int cell = last; cell != first; cell -= stride) {
+        cells[cell] = cells[cell - stride];
+      }
+      cells[first] = tile;
+    } else {
+      const C tile = cells[first];
+      for (int cell = first; cell != last; cell += stride) {
+        cells[cell] = cells[cell + stride];
+      }
+      cells[last] = tile;
+    }
+  }
+
+  int row(int cell) const {
+    return cell / dim;
+  }
+
+  int column(int cell) const {
+    return cell % dim;
+  }
+
+  int heuristic() const {
+    int rowSum = 0;
+    int rowMax = 0;
+    int colSum = 0;
+    int colMax = 0;
+    for (int cell = 0; cell < size; ++cell) {
+      const int tile = board[cell];
+      int dr = abs(row(tile) - row(cell));
+      int dc = abs(column(tile) - column(cell));
+      dr = dr < dim - dr ? dr : dim - dr;
+      dc = dc < dim - dc ? dc : dim - dc;
+      rowSum += dr;
+      colSum += dc;
+      rowMax = dr > rowMax ? dr : rowMax;
+      colMax = dc > colMax ? dc : colMax;
+    }
+    const int vertical = (rowSum + dim - 1) / dim;
+    const int horizontal = (colSum + dim - 1) / dim;
+    return (vertical > rowMax ? vertical : rowMax) + (horizontal > colMax ? horizontal : colMax);
+  }
+
+  // Rolls of parallel lines commute, so they are only tried in increasing line order; a line is rolled
+  // at most half way round in one direction.
+  int search(int g, int bound, int prevMove, int run) {
+    const int h = heuristic();
+    if (g + h > bound) {
+      return g + h;
+    }
+    if (h == 0) {
+      return FOUND;
+    }
+    if (nodes >= maxNodes) {
+      return MAX_BOUND;
+    }
+    int min = MAX_BOUND;
+    for (int line = 0; line < 2 * dim; ++line) {
+      const bool column = line >= dim;
+      for (int step = 1; step >= -1; step -= 2) {
+        const int move = encode(column, line % dim, step);
+        int nextRun = 1;
+        if (prevMove >= 0 && isColumn(prevMove) == column) {
+          if (lineOf(prevMove) > line % dim || move == inverse(prevMove)) {
+            continue;
+          }
+          nextRun = move == prevMove ? run + 1 : 1;
+        }
+        if (nextRun > (step > 0 ? dim / 2 : (dim - 1) / 2)) {
+          continue;
+        }
+        ++nodes;
+        apply(move, board.data());
+        path.push_back(move);
+        const int t = search(g + 1, bound, move, nextRun);
+        if (t == FOUND) {
+          return FOUND;
+        }
+        min = t < min ? t : min;
+        path.pop_back();
+        apply(inverse(move), board.data());
+      }
+    }
+    return min;
+  }
+
+  static constexpr int MAX_DIM = 16;
+  static constexpr int FOUND = -1;
+  static constexpr int MAX_BOUND = 1000;
+
+  int dim = 0;
+  int size = 0;
+  uint64_t nodes = 0;
+  uint64_t maxNodes = 5000000;
+  std::array<uint8_t, MAX_DIM * MAX_DIM> board;
+  std::vector<int> path;
+  std::vector<int> work;
+  std::vector<int> positions;
+};
+
+} // namespace tilepuzzles
+#endif
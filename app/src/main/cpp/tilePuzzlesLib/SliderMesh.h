@@ -6,6 +6,8 @@
 #endif
 
 #include "Mesh.h"
+#include "SliderScrambler.h"
+#include "SliderSolver.h"
 #include "Tile.h"
 
 using namespace std;
@@ -44,8 +46,39 @@ struct SliderMesh : Mesh<TQuadVertexBuffer, Tile> {
   virtual void init(const std::string& jsonStr) {
         Mesh::init(jsonStr);
         tiles.back().isBlank = true;
+    // no solve or hint above SliderSolver::MAX_DIM
+    canSolve = solver.init(board.rows);
+    solver.setThreads(solverThreads());
     }
 
+  // "solver": {"threads": n} in the puzzle config, otherwise one per core.
+  int solverThreads() {
+    auto solverConfig = configMgr.config["solver"];
+    if (solverConfig != nullptr && solverConfig["threads"] != nullptr) {
+      return solverConfig["threads"].get<int>();
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  // Only solvable boards; geometry follows from the dirty cells on the next update.
+  virtual void shuffle() {
+    scrambler.scramble(board.rows, board.cells.data());
+    for (int cell = 0; cell < board.size(); ++cell) {
+      board.place(cell, board.cells[cell]);
+    }
+  }
+
+  // Moves are the cells of the tiles slid into the blank, one cell at a time.
+  using Mesh::solve;
+  virtual bool solve(const std::vector<int>& cells, std::vector<int>& moves) {
+    moves.clear();
+    return canSolve && solver.solve(cells, moves);
+  }
+
+  virtual void applyMove(int move) {
+    slideTiles(tiles[board.tileAt(move)]);
+  }
+
   virtual Tile* const blankTile() {
     auto tileIter = std::find_if(tiles.begin(), tiles.end(), [](const Tile& t) { return t.isBlank; });
         if (tileIter != tiles.end()) {
@@ -58,46 +91,49 @@ struct SliderMesh : Mesh<TQuadVertexBuffer, Tile> {
 
   virtual void slideTiles(const Tile& tile) {
         auto tiles = tilesToSlide(tile);
-    Tile* blank = blankTile();
-    std::for_each(tiles.begin(), tiles.end(), [blank](Tile* t) { t->swap(blank); });
+    const int blankSlot = slotOf(*blankTile());
+    std::for_each(tiles.begin(), tiles.end(), [this, blankSlot](Tile* t) {
+      board.swapCells(board.cellOf(slotOf(*t)), board.cellOf(blankSlot));
+    });
     }
 
   std::vector<Tile*> tilesToSlide(const Tile& tile) {
         Direction dir = canSlide(tile);
-    Tile* blank = blankTile();
+    const math::int2 blankCoord = gridCoordOf(*blankTile());
+    const math::int2 tileCoord = gridCoordOf(tile);
     auto sliderTiles = std::vector<Tile*>();
         switch (dir) {
             case Direction::left: {
-                int row = blank->gridCoord.x;
-                int tileCol = tile.gridCoord.y;
-                int blankCol = blank->gridCoord.y;
+                int row = blankCoord.x;
+                int tileCol = tileCoord.y;
+                int blankCol = blankCoord.y;
                 for (int c = blankCol + 1; c <= tileCol; ++c) {
                     sliderTiles.push_back(tileAt(row, c));
                 }
                 return sliderTiles;
             }
             case Direction::right: {
-                int row = blank->gridCoord.x;
-                int tileCol = tile.gridCoord.y;
-                int blankCol = blank->gridCoord.y;
+                int row = blankCoord.x;
+                int tileCol = tileCoord.y;
+                int blankCol = blankCoord.y;
                 for (int c = blankCol - 1; c >= tileCol; --c) {
                     sliderTiles.push_back(tileAt(row, c));
                 }
                 return sliderTiles;
             }
             case Direction::down: {
-                int col = blank->gridCoord.y;
-                int tileRow = tile.gridCoord.x;
-                int blankRow = blank->gridCoord.x;
+                int col = blankCoord.y;
+                int tileRow = tileCoord.x;
+                int blankRow = blankCoord.x;
                 for (int r = blankRow - 1; r >= tileRow; --r) {
                     sliderTiles.push_back(tileAt(r, col));
                 }
                 return sliderTiles;
             }
             case Direction::up: {
-                int col = blank->gridCoord.y;
-                int tileRow = tile.gridCoord.x;
-                int blankRow = blank->gridCoord.x;
+                int col = blankCoord.y;
+                int tileRow = tileCoord.x;
+                int blankRow = blankCoord.x;
                 for (int r = blankRow + 1; r <= tileRow; ++r) {
                     sliderTiles.push_back(tileAt(r, col));
                 }
@@ -112,15 +148,21 @@ struct SliderMesh : Mesh<TQuadVertexBuffer, Tile> {
         Direction res = Direction::none;
     Tile* blank = blankTile();
         if (blank) {
-      res = blank->gridCoord.x == tile.gridCoord.x
-                ? blank->gridCoord.y > tile.gridCoord.y ? Direction::right : Direction::left
-                : blank->gridCoord.y == tile.gridCoord.y
-                  ? blank->gridCoord.x > tile.gridCoord.x ? Direction::down : Direction::up
+      const math::int2 blankCoord = gridCoordOf(*blank);
+      const math::int2 tileCoord = gridCoordOf(tile);
+      res = blankCoord.x == tileCoord.x
+                ? blankCoord.y > tileCoord.y ? Direction::right : Direction::left
+                : blankCoord.y == tileCoord.y
+                  ? blankCoord.x > tileCoord.x ? Direction::down : Direction::up
                   : Direction::none;
         }
         return res;
     }
 
+  SliderSolver solver;
+  bool canSolve = false;
+  SliderScrambler scrambler{(uint64_t)rand()};
+
 #ifdef USE_SDL
     constexpr static Logger L = Logger::getLogger();
 #endif
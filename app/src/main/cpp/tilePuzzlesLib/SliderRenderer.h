@@ -7,6 +7,7 @@
 #include "GLogger.h"
 #endif
 
+#include "PatternDatabase.h"
 #include "SliderMesh.h"
 #include "TRenderer.h"
 #include "Tile.h"
@@ -57,8 +58,40 @@ struct SliderRenderer : TRenderer<TQuadVertexBuffer, Tile> {
 
     virtual void initMesh() {
         mesh->init(CFG);
+        loadPatternDatabase();
     }
 
+  // Maps data/sliderNxN.pdb, written by tools/pdb_builder; only 4x4 ships one, with 5-5-5 patterns. The
+  // asset has to be stored uncompressed (noCompress "pdb") to be mapped; a compressed one is read into
+  // memory instead. Without a database the solver uses Manhattan distance and linear conflicts.
+  void loadPatternDatabase() {
+    SliderMesh* sliderMesh = static_cast<SliderMesh*>(mesh.get());
+    const int rows = sliderMesh->board.rows;
+    if (std::find(std::begin(PATTERN_DATABASE_DIMS), std::end(PATTERN_DATABASE_DIMS), rows) ==
+        std::end(PATTERN_DATABASE_DIMS)) {
+      return;
+    }
+    const std::string dim = std::to_string(rows);
+    Path path = IOUtil::getDataPath(("slider" + dim + "x" + dim + ".pdb").c_str());
+    off_t start = 0;
+    off_t length = 0;
+    bool loaded = false;
+    int fd = IOUtil::openAssetDescriptor(path, start, length);
+    if (fd >= 0) {
+      loaded = pdb.map(fd, start, length);
+      close(fd);
+    } else {
+      pdbData = IOUtil::loadBinaryAsset(path);
+      loaded = pdb.attach(pdbData.data(), pdbData.size());
+    }
+    if (loaded) {
+      sliderMesh->solver.setPatternDatabase(&pdb);
+    } else {
+      pdb.close();
+      pdbData.clear();
+    }
+  }
+
   // static constexpr const char* CFG = R"({
   //   "type":"slider",
   //     "dimension": {
@@ -78,6 +111,13 @@ struct SliderRenderer : TRenderer<TQuadVertexBuffer, Tile> {
         "count":15 
       }
   })";
+
+  // board sizes that ship a database under data/, see the pattern_databases tool target
+  static constexpr int PATTERN_DATABASE_DIMS[] = {4};
+
+  // the database when the asset could not be mapped
+  std::vector<unsigned char> pdbData;
+  PatternDatabase pdb;
 };
 
 } // namespace tilepuzzles
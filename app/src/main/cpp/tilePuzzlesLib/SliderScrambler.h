@@ -0,0 +1,81 @@
+#ifndef _SLIDER_SCRAMBLER_H_
+#define _SLIDER_SCRAMBLER_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Uniformly random solvable sliding puzzle boards in O(n), written as cell -> tile slot with the blank as
+// the last slot (see BoardState). A Fisher-Yates shuffle of all cells is solvable exactly when the
+// permutation parity equals the parity of the blank's distance from its home cell. Otherwise the tiles
+// on the first two non blank cells are swapped, which flips the parity and pairs every unsolvable board
+// with one solvable board, so the result stays uniform. Boards go up to MAX_DIM, where the slots still fit
+// uint16_t cells.
+struct SliderScrambler {
+  explicit SliderScrambler(uint64_t seed = 1) : state(seed ? seed : 1) {
+  }
+
+  void scramble(int dim, uint16_t* cells) {
+    const int size = dim * dim;
+    for (int i = 0; i < size; ++i) {
+      cells[i] = i;
+    }
+    for (int i = size - 1; i >= 1; --i) {
+      const int j = below(i + 1);
+      const uint16_t tile = cells[i];
+      cells[i] = cells[j];
+      cells[j] = tile;
+    }
+    int blank = 0;
+    while (cells[blank] != size - 1) {
+      ++blank;
+    }
+    const int blankDistance = (dim - 1 - blank / dim) + (dim - 1 - blank % dim);
+    if (isOdd(cells, size) != (blankDistance % 2 == 1)) {
+      const int a = blank == 0 ? 1 : 0;
+      const int b = blank <= 1 ? 2 : 1;
+      const uint16_t tile = cells[a];
+      cells[a] = cells[b];
+      cells[b] = tile;
+    }
+  }
+
+  // Permutation parity from the cycle count: n - cycles transpositions.
+  bool isOdd(const uint16_t* cells, int size) {
+    seen.assign((size + 63) / 64, 0);
+    int cycles = 0;
+    for (int i = 0; i < size; ++i) {
+      if (seen[i / 64] & (1ULL << (i % 64))) {
+        continue;
+      }
+      ++cycles;
+      for (int j = i; !(seen[j / 64] & (1ULL << (j % 64))); j = cells[j]) {
+        seen[j / 64] |= 1ULL << (j % 64);
+      }
+    }
+    return (size - cycles) % 2 == 1;
+  }
+
+  // xorshift64*
+  uint64_t next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+  }
+
+  // Uniform in [0, bound) by multiply and shift; the bias, about bound / 2^32, is negligible for boards.
+  int below(int bound) {
+    return (int)(((next() >> 32) * (uint64_t)bound) >> 32);
+  }
+
+  static constexpr int MAX_DIM = 255;
+
+  uint64_t state;
+  // visited cells of isOdd, kept between calls
+  std::vector<uint64_t> seen;
+};
+
+} // namespace tilepuzzles
+#endif
@@ -0,0 +1,389 @@
+#ifndef _SLIDER_SOLVER_H_
+#define _SLIDER_SOLVER_H_
+
+#include "PatternDatabase.h"
+#include "ThreadPool.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <stdint.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Optimal solver for the sliding puzzle: IDA* over a byte packed board with Manhattan distance and
+// linear conflicts, both updated incrementally per move. When a pattern database for the board size is
+// set, the larger of its additive value and Manhattan distance plus linear conflicts is used; both are
+// admissible, and a weak partition can fall below the latter.
+// A board is given as cell -> tile slot (see BoardState); the blank is the last slot and the goal is
+// the identity. Moves are returned as the cells the blank travels to, i.e. the tile on that cell is slid.
+struct SliderSolver {
+  // The tables hold boards up to MAX_DIM; larger ones leave the solver empty, so every solve fails.
+  bool init(int dim) {
+    if (dim < 2 || dim > MAX_DIM) {
+      this->dim = size = 0;
+      pdb = nullptr;
+      return false;
+    }
+    this->dim = dim;
+    size = dim * dim;
+    blankTile = size - 1;
+    for (int tile = 0; tile < size; ++tile) {
+      for (int cell = 0; cell < size; ++cell) {
+        manhattanTable[tile * MAX_CELLS + cell] =
+          tile == blankTile ? 0 : abs(tile / dim - cell / dim) + abs(tile % dim - cell % dim);
+      }
+    }
+    for (int cell = 0; cell < size; ++cell) {
+      const int r = cell / dim;
+      const int c = cell % dim;
+      int count = 0;
+      if (r > 0)
+        neighbors[cell][count++] = cell - dim;
+      if (r < dim - 1)
+        neighbors[cell][count++] = cell + dim;
+      if (c > 0)
+        neighbors[cell][count++] = cell - 1;
+      if (c < dim - 1)
+        neighbors[cell][count++] = cell + 1;
+      neighborCount[cell] = count;
+    }
+    return true;
+  }
+
+  static bool isSolvable(const std::vector<int>& cells, int dim) {
+    const int size = cells.size();
+    int inversions = 0;
+    int blankRow = 0;
+    for (int i = 0; i < size; ++i) {
+      if (cells[i] == size - 1) {
+        blankRow = i / dim;
+        continue;
+      }
+      for (int j = i + 1; j < size; ++j) {
+        if (cells[j] != size - 1 && cells[j] < cells[i]) {
+          ++inversions;
+        }
+      }
+    }
+    if (dim % 2) {
+      return inversions % 2 == 0;
+    }
+    return (inversions + (dim - 1 - blankRow)) % 2 == 0;
+  }
+
+  void setPatternDatabase(const PatternDatabase* pdb) {
+    this->pdb = pdb && pdb->isOpen() && pdb->dim == dim ? pdb : nullptr;
+  }
+
+  // More than one thread splits every IDA* iteration into subtrees searched on a work-stealing pool.
+  void setThreads(int threads) {
+    this->threads = threads < 1 ? 1 : threads;
+    if (pool && pool->size() != this->threads) {
+      pool.reset();
+    }
+  }
+
+  bool solve(const std::vector<int>& cells, std::vector<int>& moves) {
+    moves.clear();
+    nodes = 0;
+    if (cells.size() != size || !isSolvable(cells, dim)) {
+      return false;
+    }
+    load(cells);
+    int bound = heuristic();
+    while (bound < MAX_BOUND) {
+      const int t = threads > 1 ? searchParallel(bound) : search(0, bound, -1);
+      if (t == FOUND) {
+        moves = path;
+        return true;
+      }
+      bound = t;
+    }
+    return false;
+  }
+
+  void load(const std::vector<int>& cells) {
+    manhattan = 0;
+    for (int cell = 0; cell < size; ++cell) {
+      board[cell] = cells[cell];
+      positions[cells[cell]] = cell;
+      if (cells[cell] == blankTile) {
+        blank = cell;
+      }
+      manhattan += manhattanTable[cells[cell] * MAX_CELLS + cell];
+    }
+    conflicts = 0;
+    patternTotal = 0;
+    if (pdb) {
+      for (int p = 0; p < pdb->patterns.size(); ++p) {
+        patternValues[p] = pdb->value(p, positions.data());
+        patternTotal += patternValues[p];
+      }
+    }
+    for (int i = 0; i < dim; ++i) {
+      rowConflicts[i] = lineConflicts(i, true);
+      colConflicts[i] = lineConflicts(i, false);
+      conflicts += rowConflicts[i] + colConflicts[i];
+    }
+    path.clear();
+  }
+
+  // Tiles in a row or column that must leave it to let the others pass: line length minus the longest
+  // run already in goal order, counting only tiles whose goal is on this line.
+  int lineConflicts(int line, bool isRow) const {
+    int goals[MAX_DIM];
+    int count = 0;
+    for (int i = 0; i < dim; ++i) {
+      const int tile = board[isRow ? line * dim + i : i * dim + line];
+      if (tile == blankTile) {
+        continue;
+      }
+      if (isRow ? tile / dim == line : tile % dim == line) {
+        goals[count++] = isRow ? tile % dim : tile / dim;
+      }
+    }
+    int longest = 0;
+    int run[MAX_DIM];
+    for (int i = 0; i < count; ++i) {
+      run[i] = 1;
+      for (int j = 0; j < i; ++j) {
+        if (goals[j] < goals[i] && run[j] + 1 > run[i]) {
+          run[i] = run[j] + 1;
+        }
+      }
+      longest = run[i] > longest ? run[i] : longest;
+    }
+    return count - longest;
+  }
+
+  int heuristic() const {
+    const int md = manhattan + 2 * conflicts;
+    return pdb && patternTotal > md ? patternTotal : md;
+  }
+
+  // Everything needed to take back one move.
+  struct Undo {
+    int from;
+    int to;
+    int tile;
+    int manhattan;
+    int conflicts;
+    int patternTotal;
+    int pattern;
+    int patternValue;
+    bool vertical;
+    int lineA;
+    int lineB;
+    int lineConflictsA;
+    int lineConflictsB;
+  };
+
+  // Slides the tile on cell 'to' into the blank and updates the heuristic terms it affects. Forced inline:
+  // search is recursive and an out of line call per node costs about 15%.
+  __attribute__((always_inline)) void move(int to, Undo& undo) {
+    const int from = blank;
+    const int tile = board[to];
+    undo = {from, to, tile, manhattan, conflicts, patternTotal, 0, 0, to / dim != from / dim, 0, 0, 0, 0};
+    board[from] = tile;
+    board[to] = blankTile;
+    positions[tile] = from;
+    blank = to;
+    path.push_back(to);
+    manhattan += manhattanTable[tile * MAX_CELLS + from] - manhattanTable[tile * MAX_CELLS + to];
+    if (pdb) {
+      undo.pattern = pdb->patternOf[tile];
+      undo.patternValue = patternValues[undo.pattern];
+      patternValues[undo.pattern] = pdb->value(undo.pattern, positions.data());
+      patternTotal += patternValues[undo.pattern] - undo.patternValue;
+    }
+    // a vertical move changes the rows of the tile, a horizontal one its columns
+    std::array<uint8_t, MAX_DIM>& lines = undo.vertical ? rowConflicts : colConflicts;
+    undo.lineA = undo.vertical ? from / dim : from % dim;
+    undo.lineB = undo.vertical ? to / dim : to % dim;
+    undo.lineConflictsA = lines[undo.lineA];
+    undo.lineConflictsB = lines[undo.lineB];
+    lines[undo.lineA] = lineConflicts(undo.lineA, undo.vertical);
+    lines[undo.lineB] = lineConflicts(undo.lineB, undo.vertical);
+    conflicts += lines[undo.lineA] + lines[undo.lineB] - undo.lineConflictsA - undo.lineConflictsB;
+  }
+
+  __attribute__((always_inline)) void unmove(const Undo& undo) {
+    if (pdb) {
+      patternValues[undo.pattern] = undo.patternValue;
+    }
+    std::array<uint8_t, MAX_DIM>& lines = undo.vertical ? rowConflicts : colConflicts;
+    lines[undo.lineA] = undo.lineConflictsA;
+    lines[undo.lineB] = undo.lineConflictsB;
+    patternTotal = undo.patternTotal;
+    conflicts = undo.conflicts;
+    manhattan = undo.manhattan;
+    path.pop_back();
+    blank = undo.from;
+    positions[undo.tile] = undo.to;
+    board[undo.to] = undo.tile;
+    board[undo.from] = blankTile;
+  }
+
+  int search(int g, int bound, int prevBlank) {
+    const int f = g + heuristic();
+    if (f > bound) {
+      return f;
+    }
+    if (manhattan == 0) {
+      return FOUND;
+    }
+    if (stop && stop->load(std::memory_order_relaxed)) {
+      return MAX_BOUND;
+    }
+    int min = MAX_BOUND;
+    const int from = blank;
+    Undo undo;
+    for (int i = 0; i < neighborCount[from]; ++i) {
+      const int to = neighbors[from][i];
+      if (to == prevBlank) {
+        continue;
+      }
+      ++nodes;
+      move(to, undo);
+      const int t = search(g + 1, bound, from);
+      if (t == FOUND) {
+        return FOUND;
+      }
+      min = t < min ? t : min;
+      unmove(undo);
+    }
+    return min;
+  }
+
+  // A subtree root for the parallel search: the board after the moves in path.
+  struct Split {
+    std::vector<int> cells;
+    std::vector<int> path;
+    int prevBlank;
+  };
+
+  // Same walk as search, but nodes at depth become tasks instead of being searched.
+  int collect(int g, int bound, int prevBlank, int depth, std::vector<Split>& splits) {
+    const int f = g + heuristic();
+    if (f > bound) {
+      return f;
+    }
+    if (manhattan == 0) {
+      return FOUND;
+    }
+    if (g == depth) {
+      splits.push_back({std::vector<int>(board.begin(), board.begin() + size), path, prevBlank});
+      return MAX_BOUND;
+    }
+    int min = MAX_BOUND;
+    const int from = blank;
+    Undo undo;
+    for (int i = 0; i < neighborCount[from]; ++i) {
+      const int to = neighbors[from][i];
+      if (to == prevBlank) {
+        continue;
+      }
+      ++nodes;
+      move(to, undo);
+      const int t = collect(g + 1, bound, from, depth, splits);
+      if (t == FOUND) {
+        return FOUND;
+      }
+      min = t < min ? t : min;
+      unmove(undo);
+    }
+    return min;
+  }
+
+  // One IDA* iteration on the pool. The frontier is split deep enough to give every thread several
+  // subtrees; the first subtree to reach the goal stops the others, since any solution within the
+  // bound is optimal.
+  int searchParallel(int bound) {
+    std::vector<Split> splits;
+    int min = MAX_BOUND;
+    for (int depth = 0; splits.size() < threads * TASKS_PER_THREAD && depth <= bound; depth += 2) {
+      splits.clear();
+      min = collect(0, bound, -1, depth, splits);
+      if (min == FOUND) {
+        return FOUND;
+      }
+    }
+    if (!pool) {
+      pool = std::make_shared<ThreadPool>(threads);
+    }
+    // Tasks copy this snapshot, never *this: the solver is only written again after wait().
+    SliderSolver snapshot(*this);
+    snapshot.path.clear();
+    snapshot.pool.reset();
+    snapshot.nodes = 0;
+    const SliderSolver& prototype = snapshot;
+    std::atomic<bool> found{false};
+    std::atomic<int> next{min};
+    std::atomic<uint64_t> workerNodes{0};
+    std::mutex resultMutex;
+    std::vector<int> result;
+    for (const Split& split : splits) {
+      pool->submit([&prototype, &split, bound, &found, &next, &workerNodes, &resultMutex, &result] {
+        if (found.load(std::memory_order_relaxed)) {
+          return;
+        }
+        SliderSolver worker(prototype);
+        worker.stop = &found;
+        worker.load(split.cells);
+        worker.path = split.path;
+        const int t = worker.search(split.path.size(), bound, split.prevBlank);
+        workerNodes += worker.nodes;
+        if (t == FOUND) {
+          std::lock_guard<std::mutex> lock(resultMutex);
+          if (!found) {
+            result = worker.path;
+            found = true;
+          }
+          return;
+        }
+        for (int cur = next.load(); t < cur && !next.compare_exchange_weak(cur, t);) {
+        }
+      });
+    }
+    pool->wait();
+    nodes += workerNodes;
+    if (found) {
+      path = result;
+      return FOUND;
+    }
+    return next.load();
+  }
+
+  static constexpr int TASKS_PER_THREAD = 16;
+  static constexpr int MAX_DIM = 8;
+  static constexpr int MAX_CELLS = MAX_DIM * MAX_DIM;
+  static constexpr int FOUND = -1;
+  static constexpr int MAX_BOUND = 1000;
+
+  int dim = 0;
+  int size = 0;
+  int blankTile = 0;
+  int blank = 0;
+  int manhattan = 0;
+  int conflicts = 0;
+  int patternTotal = 0;
+  uint64_t nodes = 0;
+  int threads = 1;
+  std::shared_ptr<ThreadPool> pool;
+  const std::atomic<bool>* stop = nullptr;
+  const PatternDatabase* pdb = nullptr;
+  std::array<uint8_t, MAX_CELLS> board;
+  std::array<uint8_t, MAX_CELLS> positions;
+  std::array<uint8_t, MAX_CELLS> patternValues;
+  std::array<uint8_t, MAX_CELLS * MAX_CELLS> manhattanTable;
+  std::array<std::array<uint8_t, 4>, MAX_CELLS> neighbors;
+  std::array<uint8_t, MAX_CELLS> neighborCount;
+  std::array<uint8_t, MAX_DIM> rowConflicts;
+  std::array<uint8_t, MAX_DIM> colConflicts;
+  std::vector<int> path;
+};
+
+} // namespace tilepuzzles
+#endif
@@ -0,0 +1,78 @@
+#ifndef _STAGING_RING_H_
+#define _STAGING_RING_H_
+
+#include <atomic>
+#include <stdlib.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Fixed pool of upload blocks handed to Filament BufferDescriptors. acquire() walks the ring from the last
+// slot handed out and takes the first one the backend has released, for the caller to fill; release() is the
+// descriptor callback and may run on the driver thread. The blocks are allocated once, so steady state
+// uploads do not touch the allocator. When every slot is still in flight acquire() returns nullptr and the caller falls back to
+// a malloc released with free, counted in overflows.
+struct StagingRing {
+  struct Slot {
+    void* data = nullptr;
+    std::atomic<bool> busy{false};
+    StagingRing* ring = nullptr;
+  };
+
+  StagingRing(int slotCount, size_t slotSize) : slots(slotCount), slotSize(slotSize) {
+    for (Slot& slot : slots) {
+      slot.data = malloc(slotSize);
+      slot.ring = this;
+    }
+  }
+
+  ~StagingRing() {
+    for (Slot& slot : slots) {
+      free(slot.data);
+    }
+  }
+
+  StagingRing(const StagingRing&) = delete;
+  StagingRing& operator=(const StagingRing&) = delete;
+
+  // Free slot for size bytes; user is the value to pass back to release().
+  void* acquire(size_t size, void*& user) {
+    if (size > slotSize) {
+      ++overflows;
+      return nullptr;
+    }
+    for (int i = 0; i < slots.size(); ++i) {
+      Slot& slot = slots[(next + i) % slots.size()];
+      if (!slot.busy.load(std::memory_order_acquire)) {
+        slot.busy.store(true, std::memory_order_relaxed);
+        next = (next + i + 1) % slots.size();
+        const int used = inFlight.fetch_add(1, std::memory_order_relaxed) + 1;
+        highWater = used > highWater ? used : highWater;
+        user = &slot;
+        return slot.data;
+      }
+    }
+    ++overflows;
+    return nullptr;
+  }
+
+  static void release(void* buffer, size_t size, void* user) {
+    Slot* slot = (Slot*)user;
+    slot->ring->inFlight.fetch_sub(1, std::memory_order_relaxed);
+    slot->busy.store(false, std::memory_order_release);
+  }
+
+  int size() const {
+    return slots.size();
+  }
+
+  std::vector<Slot> slots;
+  size_t slotSize;
+  int next = 0;
+  std::atomic<int> inFlight{0};
+  int highWater = 0;
+  int overflows = 0;
+};
+
+} // namespace tilepuzzles
+#endif
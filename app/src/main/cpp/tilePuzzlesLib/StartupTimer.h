@@ -0,0 +1,80 @@
+#ifndef _STARTUP_TIMER_H_
+#define _STARTUP_TIMER_H_
+
+#ifdef USE_SDL
+#include "GLogger.h"
+#else
+#include "android_debug.h"
+#endif
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Startup phases on one clock, for tracking time to first frame. Phases run on several threads and may
+// overlap, so each is kept with its start offset; the report is logged once, at the first presented frame.
+struct StartupTimer {
+  using Clock = std::chrono::steady_clock;
+
+  struct Phase {
+    std::string name;
+    double startMs;
+    double durationMs;
+  };
+
+  void start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    origin = Clock::now();
+    phases.clear();
+    reported = false;
+  }
+
+  static Clock::time_point now() {
+    return Clock::now();
+  }
+
+  // Phase name ran from begin until now.
+  void record(const char* name, Clock::time_point begin) {
+    const Clock::time_point end = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    phases.push_back({name, ms(begin - origin), ms(end - begin)});
+  }
+
+  void firstFrame() {
+    if (reported) {
+      return;
+    }
+    reported = true;
+    record("first frame", origin);
+    report();
+  }
+
+  void report() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Phase& phase : phases) {
+#ifdef USE_SDL
+      L.info("startup", phase.name, "at ms:", phase.startMs, "took ms:", phase.durationMs);
+#else
+      LOGI("startup %s at ms: %.1f took ms: %.1f", phase.name.c_str(), phase.startMs, phase.durationMs);
+#endif
+    }
+  }
+
+  static double ms(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+
+  Clock::time_point origin = Clock::now();
+  std::vector<Phase> phases;
+  std::mutex mutex;
+  bool reported = false;
+#ifdef USE_SDL
+  constexpr static Logger L = Logger::getLogger();
+#endif
+};
+
+} // namespace tilepuzzles
+#endif
@@ -10,10 +10,15 @@
 #include "GameUtil.h"
 #include "HexSpinRenderer.h"
 #include "IRenderer.h"
+#include "PreviewPane.h"
+#include "ResourceCache.h"
 #include "RollerRenderer.h"
 #include "SliderRenderer.h"
+#include "StartupTimer.h"
 #include "TRenderer.h"
+#include "ThreadPool.h"
 #include "Tile.h"
+#include "TouchQueue.h"
 
 #include "generated/resources/resources.h"
 #include <filament/Camera.h>
@@ -47,8 +52,11 @@
 #include <utils/Panic.h>
 #include <utils/Path.h>
 
+#include <algorithm>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <thread>
 #include <valarray>
 
 using namespace filament;
@@ -58,10 +66,6 @@ using utils::Path;
 
 namespace tilepuzzles {
 
-static constexpr int ACTION_DOWN = 0;
-static constexpr int ACTION_UP = 1;
-static constexpr int ACTION_MOVE = 2;
-
 #ifdef USE_SDL
 static constexpr uint32_t WINDOW_FLAGS = SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE;
 #endif
@@ -76,31 +80,71 @@ struct TAppWin {
 
   void createSwapChain(void* nativeWindow) {
     swapChain = app.engine->createSwapChain(nativeWindow);
+    needsDraw = true;
   }
 
   void init() {
+#ifdef USE_SDL
+    ASSERT_POSTCONDITION(SDL_Init(SDL_INIT_EVENTS) == 0, "SDL_Init Failure");
+#endif
+    startup();
+#ifdef USE_SDL
+    game_loop(0.);
+    cleanup();
+#endif
+  }
+
+  // Startup task graph. A worker builds the meshes and queues the asset reads and image decodes on the pool
+  // while this thread creates the engine; Filament objects are then created here, each acquire joining only
+  // the decode it needs. Phase timings are logged at the first frame.
+  void startup() {
+    startupTimer.start();
+    GameUtil::GameUtil::init();
+    createRenderer();
+    resources.reset(new ResourceCache(nullptr));
+    ThreadPool pool(std::max(2, int(std::thread::hardware_concurrency()) - 1));
+    std::promise<void> prepared;
+    std::future<void> meshes = prepared.get_future();
+    pool.submit([this, &pool, &prepared] {
+      const auto start = StartupTimer::now();
+      try {
+        renderer->prepare(*resources, pool);
+        if (roRenderer) {
+          roRenderer->prepare(*resources, pool);
+        }
+        prepared.set_value();
+      } catch (...) {
+        prepared.set_exception(std::current_exception());
+      }
+      startupTimer.record("meshes", start);
+    });
+
+    auto start = StartupTimer::now();
     app.engine = Engine::create();
     app.filaRenderer = app.engine->createRenderer();
     // app.scene = app.engine->createScene();
     app.skybox =
       Skybox::Builder().showSun(true).color({0. / 255., 0. / 255., 0. / 255., 1.f}).build(*app.engine);
     // app.scene->setSkybox(app.skybox);
-#ifdef USE_SDL
-    ASSERT_POSTCONDITION(SDL_Init(SDL_INIT_EVENTS) == 0, "SDL_Init Failure");
-    GameUtil::GameUtil::init();
-    createRenderer();
+    resources->engine = app.engine;
+    app.resources = resources.get();
+    startupTimer.record("engine", start);
+
+    start = StartupTimer::now();
+    meshes.get();
+    startupTimer.record("join meshes", start);
+
+    start = StartupTimer::now();
     initRenderer();
+#ifdef USE_SDL
     createWinow();
     setup_window();
-    setup_animating_scene();
-    game_loop(0.);
-    cleanup();
-#else
-    GameUtil::GameUtil::init();
-    createRenderer();
-    initRenderer();
-    setup_animating_scene();
 #endif
+    startupTimer.record("views", start);
+
+    start = StartupTimer::now();
+    setup_animating_scene();
+    startupTimer.record("draw", start);
   }
 
   void initRenderer() {
@@ -110,6 +154,10 @@ struct TAppWin {
       app.viewportLayout = roVpLayout;
       roRenderer->init(app);
     }
+    if (preview) {
+      app.viewportLayout = roVpLayout;
+      preview->init(app);
+    }
   }
 
   void initRenderer1() {
@@ -138,10 +186,15 @@ struct TAppWin {
     if (roRenderer != nullptr) {
       roRenderer->destroy();
     }
+    if (preview) {
+      preview->destroy();
+    }
     if (app.engine && swapChain) {
       app.engine->destroy(swapChain);
       swapChain = nullptr;
     }
+    resources.reset();
+    app.resources = nullptr;
     app.engine->destroy(app.skybox);
     // app.engine->destroy(app.scene);
     app.engine->destroy(app.filaRenderer);
@@ -162,6 +215,7 @@ struct TAppWin {
     renderer->draw();
     if (roRenderer)
       roRenderer->draw();
+    resources->report();
     needsDraw = true;
     onNewFrame = animation_new_frame;
   }
@@ -176,19 +230,27 @@ struct TAppWin {
     // roRenderer->setReadOnly(true);
 
     renderer = std::shared_ptr<IRenderer>(new HexSpinRenderer());
-    roRenderer = std::shared_ptr<IRenderer>(new HexSpinRenderer());
-    roRenderer->setReadOnly(true);
+    if (previewMode) {
+      preview.reset(new PreviewPane([] { return std::shared_ptr<IRenderer>(new HexSpinRenderer()); }));
+    } else {
+      roRenderer = std::shared_ptr<IRenderer>(new HexSpinRenderer());
+      roRenderer->setReadOnly(true);
+    }
   }
 
   static void animation_new_frame(TAppWin& win, double dt) {
     if (win.swapChain) {
       win.renderer->update(dt);
       win.renderer->animate(dt);
+      win.needsDraw |= win.renderer->takeViewChange();
       if (win.roRenderer) {
         win.roRenderer->update(dt);
         win.roRenderer->animate(dt);
+        win.needsDraw |= win.roRenderer->takeViewChange();
+      }
+      if (win.preview) {
+        win.needsDraw |= win.preview->takeViewChange();
       }
-      win.needsDraw = true;
     }
   }
 
@@ -236,11 +298,45 @@ struct TAppWin {
     renderer->resize(width, height);
     if (roRenderer)
       roRenderer->resize(width, height);
+    if (preview)
+      preview->resize(width, height);
     needsDraw = true;
   }
 
+  // Called from the UI thread; the event is handled by the game loop's next frame.
   void touchAction(int action, float x, float y) {
-    static bool buttonDown = false;
+    touches.push({action, x, y, 0});
+  }
+
+  // A MotionEvent's historical samples and its current one, queued in one call.
+  void touchActions(const TouchSample* samples, int count) {
+    for (int i = 0; i < count; ++i) {
+      touches.push({samples[i].action, samples[i].x, samples[i].y, samples[i].time});
+    }
+  }
+
+  void processTouches() {
+    touches.drain([this](const TouchEvent* events, int count) {
+      if (events[0].action == ACTION_MOVE) {
+        handleDrag(events, count);
+      } else {
+        handleTouch(events[0].action, events[0].x, events[0].y);
+      }
+    });
+  }
+
+  void handleDrag(const TouchEvent* events, int count) {
+    if (!buttonDown) {
+      return;
+    }
+    dragPath.clear();
+    for (int i = 0; i < count; ++i) {
+      dragPath.push_back({events[i].x, events[i].y});
+    }
+    renderer->onMouseDrag(dragPath.data(), count);
+  }
+
+  void handleTouch(int action, float x, float y) {
     switch (action) {
       case ACTION_DOWN: {
         math::float2 mouseDownPos = {x, y};
@@ -273,7 +369,6 @@ struct TAppWin {
     const Uint64 kCounterFrequency = SDL_GetPerformanceFrequency();
     Uint32 totalFrameTicks = 0;
     Uint32 totalFrames = 0;
-    bool buttonDown = false;
 
     while (nClosed < 1) {
       totalFrames++;
@@ -291,21 +386,15 @@ struct TAppWin {
             break;
 
           case SDL_MOUSEMOTION:
-            if (buttonDown) {
-              filament::math::float2 pos = {float(event.motion.x), float(event.motion.y)};
-              renderer->onMouseMove(pos);
-            }
+            touchAction(ACTION_MOVE, float(event.motion.x), float(event.motion.y));
             break;
 
           case SDL_MOUSEBUTTONDOWN:
 
             switch (event.button.button) {
-              case SDL_BUTTON_LEFT: {
-                math::float2 mouseDownPos = {float(event.button.x), float(event.button.y)};
-                renderer->onMouseDown(mouseDownPos);
-                buttonDown = true;
+              case SDL_BUTTON_LEFT:
+                touchAction(ACTION_DOWN, float(event.button.x), float(event.button.y));
                 break;
-              }
 
               case SDL_BUTTON_RIGHT:
                 math::float2 mouseDownPos = {float(event.button.x), float(event.button.y)};
@@ -316,12 +405,9 @@ struct TAppWin {
 
           case SDL_MOUSEBUTTONUP:
             switch (event.button.button) {
-              case SDL_BUTTON_LEFT: {
-                math::float2 mouseUpPos = {float(event.button.x), float(event.button.y)};
-                renderer->onMouseUp(mouseUpPos);
-                buttonDown = false;
+              case SDL_BUTTON_LEFT:
+                touchAction(ACTION_UP, float(event.button.x), float(event.button.y));
                 break;
-              }
 
               case SDL_BUTTON_RIGHT:
                 break;
@@ -351,6 +437,7 @@ struct TAppWin {
             break;
         }
       }
+      processTouches();
       Uint64 endTicks = SDL_GetPerformanceCounter();
       const double dt = lastTime > 0 ? (double(endTicks - lastTime) / kCounterFrequency) : (1.0 / 60.0);
       lastTime = endTicks;
@@ -360,19 +447,16 @@ struct TAppWin {
         onNewFrame(*this, time);
       }
 
-      if (!needsDraw) {
-        continue;
-      }
-
-      if (app.filaRenderer->beginFrame(swapChain)) {
-        app.filaRenderer->render(renderer->getView());
-        if (roRenderer)
-          app.filaRenderer->render(roRenderer->getView());
+      if (needsDraw && app.filaRenderer->beginFrame(swapChain)) {
+        renderViews();
         app.filaRenderer->endFrame();
+        startupTimer.firstFrame();
+        needsDraw = false;
+        lastDrawTime = time;
+        countFrame(true);
+      } else {
+        countFrame(false);
       }
-
-      needsDraw = false;
-      lastDrawTime = time;
       Uint64 frameTicks = endTicks - startTicks;
       float frameTime = (float)frameTicks / (float)kCounterFrequency;
       float delay = floor(16.666f - frameTime);
@@ -383,25 +467,47 @@ struct TAppWin {
 
   void game_loop(double t) {
     if (renderer && swapChain) {
+      processTouches();
       if (onNewFrame) {
         onNewFrame(*this, t);
       }
 
-      if (needsDraw) {
-        if (app.filaRenderer->beginFrame(swapChain)) {
-          app.filaRenderer->render(renderer->getView());
-          if (roRenderer)
-            app.filaRenderer->render(roRenderer->getView());
-          app.filaRenderer->endFrame();
-        }
+      if (needsDraw && app.filaRenderer->beginFrame(swapChain)) {
+        renderViews();
+        app.filaRenderer->endFrame();
+        startupTimer.firstFrame();
         needsDraw = false;
         lastDrawTime = t;
+        countFrame(true);
+      } else {
+        countFrame(false);
       }
     }
   }
 
 #endif
 
+  void renderViews() {
+    app.filaRenderer->render(renderer->getView());
+    if (roRenderer)
+      app.filaRenderer->render(roRenderer->getView());
+    if (preview && preview->isCaptured())
+      app.filaRenderer->render(preview->getView());
+  }
+
+  // Frames drawn against frame callbacks with nothing to draw, or the backend not ready for another frame.
+  void countFrame(bool rendered) {
+    ++(rendered ? framesRendered : framesSkipped);
+    if ((framesRendered + framesSkipped) % kFrameReportInterval == 0) {
+#ifdef USE_SDL
+      L.info("frames rendered:", framesRendered, "skipped:", framesSkipped);
+#else
+      LOGI("frames rendered: %llu skipped: %llu", (unsigned long long)framesRendered,
+           (unsigned long long)framesSkipped);
+#endif
+    }
+  }
+
 #if defined(__APPLE__)
   Engine::Backend kBackend = filament::Engine::Backend::METAL;
 #endif
@@ -411,10 +517,21 @@ struct TAppWin {
   SDL_Window* sdl_window = nullptr;
 #endif
   bool needsDraw = true;
+  TouchQueue touches;
+  std::vector<math::float2> dragPath;
+  bool buttonDown = false;
+  static constexpr uint64_t kFrameReportInterval = 3600;
+  uint64_t framesRendered = 0;
+  uint64_t framesSkipped = 0;
   double time = 0.0;
   double lastDrawTime = 0.0;
   std::shared_ptr<IRenderer> renderer;
   std::shared_ptr<IRenderer> roRenderer;
+  // Shows the read-only board as a captured texture instead of running roRenderer every frame.
+  bool previewMode = true;
+  std::unique_ptr<PreviewPane> preview;
+  std::unique_ptr<ResourceCache> resources;
+  StartupTimer startupTimer;
   SwapChain* swapChain = nullptr;
   GameContext* gameContext;
   App app;
@@ -7,7 +7,10 @@
 #include "IOUtil.h"
 #include "IRenderer.h"
 #include "Mesh.h"
+#include "ResourceCache.h"
+#include "StagingRing.h"
 #include "Tile.h"
+#include "TileInstances.h"
 
 #include <filament/Camera.h>
 #include <filament/Engine.h>
@@ -38,6 +41,10 @@
 #include <utils/Panic.h>
 #include <utils/Path.h>
 
+#include <chrono>
+#include <deque>
+#include <future>
+
 using namespace filament;
 using namespace filament::math;
 using utils::Entity;
@@ -65,6 +72,11 @@ struct TRenderer : IRenderer {
 
   virtual void onMouseMove(const float2& dragPosition) = 0;
 
+  // Boards that only follow the pointer need the last point alone.
+  virtual void onMouseDrag(const float2* path, int count) {
+    onMouseMove(path[count - 1]);
+  }
+
   virtual void initMesh() = 0;
 
   virtual bool isReadOnly() {
@@ -96,6 +108,28 @@ struct TRenderer : IRenderer {
       }
       camera->setProjection(Camera::Projection::ORTHO, -aspect * zoom, aspect * zoom, -zoom, zoom, kNearPlane,
                             kFarPlane);
+      viewChanged = true;
+    }
+  }
+
+  virtual bool takeViewChange() {
+    const bool changed = viewChanged;
+    viewChanged = false;
+    return changed;
+  }
+
+  // Engine independent part of startup, run on a worker: starts decoding the assets draw() will acquire and
+  // builds the mesh, which some asset choices depend on.
+  virtual void prepare(ResourceCache& resources, ThreadPool& pool) {
+    resources.prefetchTexture(getTilesTexturePath(), pool);
+    resources.prefetchTexture(getBackgroundTexturePath(), pool);
+    resources.prefetchMaterial(getBackgroundMaterialPath(), pool);
+    initMesh();
+    meshReady = true;
+    resources.prefetchMaterial(useInstances() ? getInstancedTileMaterialPath() : getTileMaterialPath(), pool);
+    if (mesh->hasBorder()) {
+      resources.prefetchTexture(getBorderTexturePath(), pool);
+      resources.prefetchMaterial(getBorderMaterialPath(), pool);
     }
   }
 
@@ -103,8 +137,11 @@ struct TRenderer : IRenderer {
     viewPortDim = app.viewportRect;
     viewportLayout = app.viewportLayout;
 
-    initMesh();
+    if (!meshReady) {
+      initMesh();
+    }
     engine = app.engine;
+    resources = app.resources;
     skybox = app.skybox;
     scene = engine->createScene();
     scene->setSkybox(skybox);
@@ -131,63 +168,123 @@ struct TRenderer : IRenderer {
     return IOUtil::getMaterialPath(FILAMAT_FILE_OPAQUE.data());
   }
 
+  virtual Path getInstancedTileMaterialPath() {
+    return IOUtil::getMaterialPath(FILAMAT_FILE_INSTANCED.data());
+  }
+
   virtual Path getAnchorMaterialPath() {
     return IOUtil::getMaterialPath(FILAMAT_FILE_MULTI_UNLIT.data());
   }
 
   virtual void destroy() {
+    // the search reads the mesh
+    if (search.valid()) {
+      search.wait();
+    }
     engine->destroy(bgRenderable);
     engine->destroy(bgMatInstance);
-    engine->destroy(bgTex);
+    resources->release(bgTex);
     engine->destroy(bgVb);
     engine->destroy(bgIb);
-    engine->destroy(bgMaterial);
+    resources->release(bgMaterial);
 
     if (mesh->hasBorder()) {
       engine->destroy(borderRenderable);
       engine->destroy(borderMatInstance);
-      engine->destroy(borderTex);
+      resources->release(borderTex);
       engine->destroy(borderVb);
       engine->destroy(borderIb);
-      engine->destroy(borderMaterial);
+      resources->release(borderMaterial);
     }
 
     engine->destroy(renderable);
     engine->destroy(matInstance);
-    engine->destroy(material);
+    resources->release(material);
     engine->destroy(vb);
     engine->destroy(ib);
+    if (instanceTex) {
+      engine->destroy(instanceTex);
+    }
     engine->destroy(light);
     engine->destroy(pointLight);
 
     view->setScene(nullptr);
-    engine->destroy(tex);
+    resources->release(tex);
     engine->destroy(scene);
     engine->destroy(view);
     engine->destroyCameraComponent(cameraEntity);
     // engine->destroy(filaRenderer);
+
+    // the staging slots must outlive the uploads still queued on the backend
+    engine->flushAndWait();
+#ifdef USE_SDL
+    L.info("staging slots:", staging->size(), "high water:", staging->highWater, "overflows:", staging->overflows);
+#else
+    LOGI("staging slots: %d high water: %d overflows: %d", staging->size(), staging->highWater,
+         staging->overflows);
+#endif
+    staging.reset();
   }
 
   virtual void update(double dt) {
+    pollSearch();
+    if (!solution.empty() && !readOnly) {
+      mesh->applyMove(solution.front());
+      solution.pop_front();
+      needsDraw = true;
+    }
     if (needsDraw && !readOnly) {
       needsDraw = false;
-      vb->setBufferAt(*engine, 0,
-                      VertexBuffer::BufferDescriptor(mesh->vertexBuffer->cloneVertices(),
-                                                     mesh->vertexBuffer->getSize(),
-                                                     (VertexBuffer::BufferDescriptor::Callback)free));
-      scene->remove(renderable);
-      auto& rcm = engine->getRenderableManager();
-      rcm.destroy(renderable);
+      viewChanged |= uploadDirtyVertices();
+    }
+  }
 
-      RenderableManager::Builder(1)
-        .boundingBox({{-1, -1, -1}, {1, 1, 1}})
-        .material(0, matInstance)
-        .geometry(0, RenderableManager::PrimitiveType::TRIANGLES, vb, ib, 0, mesh->vertexBuffer->numIndices)
-        .receiveShadows(false)
-        .castShadows(false)
-        .build(*engine, renderable);
-      scene->addEntity(renderable);
+  // Uploads the shapes written since the last upload into the live vertex buffer; the renderable built by
+  // drawTiles keeps referencing it. The bytes are staged in a ring slot the backend hands back once done.
+  // Returns false when nothing was written, so the frame can be skipped.
+  bool uploadDirtyVertices() {
+    mesh->updateGeometry();
+    auto& vertexBuffer = *mesh->vertexBuffer;
+    if (vertexBuffer.dirty.empty()) {
+      return false;
+    }
+    VertexBuffer::BufferDescriptor::Callback release;
+    void* user = nullptr;
+    if (instances) {
+      instances->update(vertexBuffer, vertexBuffer.dirty);
+      vertexBuffer.dirty.clear();
+      const DirtyRange& dirty = instances->dirty;
+      if (dirty.empty()) {
+        return false;
+      }
+      const size_t size = instances->dirtySize();
+      void* block = stage(size, release, user);
+      memcpy(block, &instances->records[dirty.begin], size);
+      instanceTex->setImage(
+        *engine, 0, dirty.begin, 0, dirty.end - dirty.begin, 1,
+        Texture::PixelBufferDescriptor(block, size, Texture::Format::RGBA, Texture::Type::FLOAT, release, user));
+      instances->dirty.clear();
+    } else {
+      const size_t size = vertexBuffer.dirtySize();
+      void* block = stage(size, release, user);
+      vertexBuffer.pack(vertexBuffer.dirty.begin, vertexBuffer.dirty.end, block);
+      vb->setBufferAt(*engine, 0, VertexBuffer::BufferDescriptor(block, size, release, user),
+                      vertexBuffer.dirtyOffset());
+      vertexBuffer.dirty.clear();
     }
+    return true;
+  }
+
+  // Free staging slot of size bytes, or a malloc block when every slot is still in flight.
+  void* stage(size_t size, VertexBuffer::BufferDescriptor::Callback& release, void*& user) {
+    void* block = staging->acquire(size, user);
+    release = &StagingRing::release;
+    if (!block) {
+      block = malloc(size);
+      release = (VertexBuffer::BufferDescriptor::Callback)free;
+      user = nullptr;
+    }
+    return block;
   }
 
   virtual void drawBackground() {
@@ -202,36 +299,21 @@ struct TRenderer : IRenderer {
       0, 1, 2, 3, 2, 1,
     };
 
-    Path path = getBackgroundTexturePath();
-    IOUtil::img_data data = IOUtil::imageLoad(path.c_str(), 4);
-    Texture::PixelBufferDescriptor buffer(data.data, size_t(data.width * data.height * 4),
-                                          Texture::Format::RGBA, Texture::Type::UBYTE,
-                                          (Texture::PixelBufferDescriptor::Callback) & ::stbi_image_free);
-
     static_assert(sizeof(Vertex) == (4 * 3) + (4 * 3) + (4 * 2), "Strange vertex size.");
-    bgTex = Texture::Builder()
-              .width(uint32_t(data.width))
-              .height(uint32_t(data.height))
-              .levels(1)
-              .sampler(Texture::Sampler::SAMPLER_2D)
-              .format(Texture::InternalFormat::RGBA8)
-              .build(*engine);
-    bgTex->setImage(*engine, 0, std::move(buffer));
-    TextureSampler sampler(MinFilter::LINEAR, MagFilter::LINEAR);
+    bgTex = resources->acquireTexture(getBackgroundTexturePath());
+    TextureSampler sampler(MinFilter::LINEAR_MIPMAP_LINEAR, MagFilter::LINEAR);
     // Create quad renderable
     bgVb = VertexBuffer::Builder()
              .vertexCount(4)
              .bufferCount(1)
-             .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, 32)
-             .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT3, 24, 32)
+             .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, sizeof(Vertex))
+             .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT2, 24, sizeof(Vertex))
              .build(*engine);
     bgVb->setBufferAt(*engine, 0, VertexBuffer::BufferDescriptor(QUAD_VERTICES, sizeof(Vertex) * 4, nullptr));
     bgIb = IndexBuffer::Builder().indexCount(6).bufferType(IndexBuffer::IndexType::USHORT).build(*engine);
     bgIb->setBuffer(*engine, IndexBuffer::BufferDescriptor(QUAD_INDICES, sizeof(uint16_t) * 6, nullptr));
 
-    Path matPath = getBackgroundMaterialPath(); // IOUtil::getMaterialPath(FILAMAT_FILE_OPAQUE.data());
-    std::vector<unsigned char> mat = IOUtil::loadBinaryAsset(matPath.c_str());
-    bgMaterial = Material::Builder().package(mat.data(), mat.size()).build(*engine);
+    bgMaterial = resources->acquireMaterial(getBackgroundMaterialPath());
 
     bgMatInstance = bgMaterial->createInstance();
     bgMatInstance->setParameter("albedo", bgTex, sampler);
@@ -249,31 +331,15 @@ struct TRenderer : IRenderer {
   virtual void drawBorder() {
     if (mesh->hasBorder()) {
       std::shared_ptr<VB> vbBorder = mesh->vertexBufferBorder;
-      Path path = getBorderTexturePath();
-      IOUtil::img_data data = IOUtil::imageLoad(path.c_str(), 4);
-      Texture::PixelBufferDescriptor buffer(data.data, size_t(data.width * data.height * 4),
-                                            Texture::Format::RGBA, Texture::Type::UBYTE,
-                                            (Texture::PixelBufferDescriptor::Callback) & ::stbi_image_free);
-
       static_assert(sizeof(Vertex) == (4 * 3) + (4 * 3) + (4 * 2), "Strange vertex size.");
-      borderTex = Texture::Builder()
-                    .width(uint32_t(data.width))
-                    .height(uint32_t(data.height))
-                    .levels(1)
-                    .sampler(Texture::Sampler::SAMPLER_2D)
-                    .format(Texture::InternalFormat::RGBA8)
-                    .build(*engine);
-      borderTex->setImage(*engine, 0, std::move(buffer));
-      TextureSampler sampler(MinFilter::LINEAR, MagFilter::LINEAR);
+      borderTex = resources->acquireTexture(getBorderTexturePath());
+      TextureSampler sampler(MinFilter::LINEAR_MIPMAP_LINEAR, MagFilter::LINEAR);
       // Create quad renderable
-      borderVb = VertexBuffer::Builder()
-                   .vertexCount(vbBorder->numVertices)
-                   .bufferCount(1)
-                   .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, 32)
-                   .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT3, 24, 32)
-                   .build(*engine);
-      borderVb->setBufferAt(
-        *engine, 0, VertexBuffer::BufferDescriptor(vbBorder->vertShapes, vbBorder->getSize(), nullptr));
+      VertexBuffer::Builder builder;
+      borderVb = VB::declare(builder.vertexCount(vbBorder->numVertices).bufferCount(1)).build(*engine);
+      borderVb->setBufferAt(*engine, 0,
+                            VertexBuffer::BufferDescriptor(vbBorder->clonePacked(), vbBorder->packedSize(),
+                                                           (VertexBuffer::BufferDescriptor::Callback)free));
       borderIb = IndexBuffer::Builder()
                    .indexCount(vbBorder->numIndices)
                    .bufferType(IndexBuffer::IndexType::USHORT)
@@ -281,9 +347,7 @@ struct TRenderer : IRenderer {
       borderIb->setBuffer(
         *engine, IndexBuffer::BufferDescriptor(vbBorder->indexShapes, vbBorder->getIndexSize(), nullptr));
 
-      Path matPath = getBorderMaterialPath(); // IOUtil::getMaterialPath(FILAMAT_FILE_UNLIT.data());
-      std::vector<unsigned char> mat = IOUtil::loadBinaryAsset(matPath.c_str());
-      borderMaterial = Material::Builder().package(mat.data(), mat.size()).build(*engine);
+      borderMaterial = resources->acquireMaterial(getBorderMaterialPath());
 
       borderMatInstance = borderMaterial->createInstance();
       borderMatInstance->setParameter("alpha", 1.f);
@@ -297,6 +361,7 @@ struct TRenderer : IRenderer {
         .receiveShadows(false)
         .castShadows(false)
         .build(*engine, borderRenderable);
+      scaleToBoard(borderRenderable);
       scene->addEntity(borderRenderable);
     }
   }
@@ -324,36 +389,28 @@ struct TRenderer : IRenderer {
   }
 
   void drawTiles() {
-    Path path = getTilesTexturePath();
-    IOUtil::img_data data = IOUtil::imageLoad(path.c_str(), 4);
-    Texture::PixelBufferDescriptor buffer(data.data, size_t(data.width * data.height * 4),
-                                          Texture::Format::RGBA, Texture::Type::UBYTE,
-                                          (Texture::PixelBufferDescriptor::Callback) & ::stbi_image_free);
-
     static_assert(sizeof(Vertex) == (4 * 3) + (4 * 3) + (4 * 2), "Strange vertex size.");
-    tex = Texture::Builder()
-            .width(uint32_t(data.width))
-            .height(uint32_t(data.height))
-            .levels(1)
-            .sampler(Texture::Sampler::SAMPLER_2D)
-            .format(Texture::InternalFormat::RGBA8)
-            .build(*engine);
-    tex->setImage(*engine, 0, std::move(buffer));
+    tex = resources->acquireTexture(getTilesTexturePath());
+    // the atlases have a single level, see bake_textures
     TextureSampler sampler(MinFilter::LINEAR, MagFilter::LINEAR);
 
     // Set up view
     view->setPostProcessingEnabled(false);
 
     // Create quad renderable
-    vb = VertexBuffer::Builder()
-           .vertexCount(mesh->vertexBuffer->numVertices)
-           .bufferCount(1)
-           .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, 32)
-           .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT3, 24, 32)
-           .build(*engine);
-    vb->setBufferAt(
-      *engine, 0,
-      VertexBuffer::BufferDescriptor(mesh->vertexBuffer->vertShapes, mesh->vertexBuffer->getSize(), nullptr));
+    mesh->updateGeometry();
+    if (useInstances()) {
+      initInstances();
+    } else {
+      VertexBuffer::Builder builder;
+      vb = VB::declare(builder.vertexCount(mesh->vertexBuffer->numVertices).bufferCount(1)).build(*engine);
+      const size_t size = mesh->vertexBuffer->packedSize();
+      vb->setBufferAt(*engine, 0,
+                      VertexBuffer::BufferDescriptor(mesh->vertexBuffer->clonePacked(), size,
+                                                     (VertexBuffer::BufferDescriptor::Callback)free));
+      staging.reset(new StagingRing(kStagingSlots, size));
+    }
+    mesh->vertexBuffer->dirty.clear();
     ib = IndexBuffer::Builder()
            .indexCount(mesh->vertexBuffer->numIndices)
            .bufferType(IndexBuffer::IndexType::USHORT)
@@ -361,12 +418,16 @@ struct TRenderer : IRenderer {
     ib->setBuffer(*engine, IndexBuffer::BufferDescriptor(mesh->vertexBuffer->indexShapes,
                                                          mesh->vertexBuffer->getIndexSize(), nullptr));
 
-    Path matPath = getTileMaterialPath();
-    std::vector<unsigned char> mat = IOUtil::loadBinaryAsset(matPath.c_str());
-    material = Material::Builder().package(mat.data(), mat.size()).build(*engine);
+    material = resources->acquireMaterial(instances ? getInstancedTileMaterialPath() : getTileMaterialPath());
     matInstance = material->createInstance();
     matInstance->setParameter("albedo", tex, sampler);
-    matInstance->setParameter("alpha", 1.f);
+    // the opaque tile materials have no alpha
+    if (material->hasParameter("alpha")) {
+      matInstance->setParameter("alpha", 1.f);
+    }
+    if (instances) {
+      matInstance->setParameter("instances", instanceTex, TextureSampler(MinFilter::NEAREST, MagFilter::NEAREST));
+    }
 
     renderable = EntityManager::get().create();
     RenderableManager::Builder(1)
@@ -377,10 +438,55 @@ struct TRenderer : IRenderer {
       .culling(false)
       .castShadows(false)
       .build(*engine, renderable);
+    if (!instances) {
+      scaleToBoard(renderable);
+    }
 
     scene->addEntity(renderable);
   }
 
+  // Layouts that store positions scaled down, see CompactVertexLayout, are scaled back here.
+  void scaleToBoard(Entity entity) {
+    if (VB::POSITION_SCALE != 1.F) {
+      const float scale = VB::POSITION_SCALE;
+      engine->getTransformManager().create(entity, {}, mat4f::scaling(float3(scale, scale, 1.F)));
+    }
+  }
+
+  // The instanced material is opt in and only ships once compiled with matc, see the materials target.
+  bool useInstances() {
+    return mesh->renderInstanced() && mesh->vertexBuffer->numVertShapes <= kMaxInstances &&
+           IOUtil::assetExists(getInstancedTileMaterialPath());
+  }
+
+  // Static corners in vb, one RGBA32F texel per tile in instanceTex, read by the vertex shader.
+  void initInstances() {
+    instances.reset(new TTileInstances<VB>());
+    instances->init(*mesh->vertexBuffer);
+    const int count = instances->records.size();
+    vb = VertexBuffer::Builder()
+           .vertexCount(instances->vertices.size())
+           .bufferCount(1)
+           .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, sizeof(InstanceVertex))
+           .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT2, 12, sizeof(InstanceVertex))
+           .attribute(VertexAttribute::CUSTOM0, 0, VertexBuffer::AttributeType::FLOAT, 20, sizeof(InstanceVertex))
+           .build(*engine);
+    vb->setBufferAt(*engine, 0,
+                    VertexBuffer::BufferDescriptor(instances->vertices.data(),
+                                                   instances->vertices.size() * sizeof(InstanceVertex), nullptr));
+    instanceTex = Texture::Builder()
+                    .width(uint32_t(count))
+                    .height(1)
+                    .levels(1)
+                    .sampler(Texture::Sampler::SAMPLER_2D)
+                    .format(Texture::InternalFormat::RGBA32F)
+                    .build(*engine);
+    instanceTex->setImage(*engine, 0,
+                          Texture::PixelBufferDescriptor(instances->records.data(), count * sizeof(TileInstance),
+                                                         Texture::Format::RGBA, Texture::Type::FLOAT));
+    staging.reset(new StagingRing(kStagingSlots, count * sizeof(TileInstance)));
+  }
+
   virtual void addLight() {
     // Add light sources into the scene.
     utils::EntityManager& em = utils::EntityManager::get();
@@ -431,10 +537,69 @@ struct TRenderer : IRenderer {
   }
 
   virtual void shuffle() {
+    solution.clear();
+    playSearch = false;
     mesh->shuffle();
     needsDraw = true;
   }
 
+  // IDA* can take seconds, so the search runs on a worker and update() queues its moves, played back
+  // one per frame. Returns the move count when this board has already been searched, otherwise -1:
+  // the search is running, or the board has no solution.
+  virtual int solve() {
+    const std::vector<int> cells = mesh->boardCells();
+    if (cells == solvedCells) {
+      solution.assign(solvedMoves.begin(), solvedMoves.end());
+      return solvedOk ? solvedMoves.size() : -1;
+    }
+    playSearch = true;
+    startSearch(cells);
+    return -1;
+  }
+
+  // Tile to move next, from a finished search on the current board. Otherwise starts one and returns
+  // -1; asking again after it finishes gives the tile.
+  virtual int hint() {
+    const std::vector<int> cells = mesh->boardCells();
+    if (cells == solvedCells) {
+      return solvedMoves.empty() ? -1 : mesh->moveTileNum(solvedMoves.front());
+    }
+    startSearch(cells);
+    return -1;
+  }
+
+  void startSearch(const std::vector<int>& cells) {
+    if (search.valid()) {
+      return; // pollSearch() restarts it if the board has moved on
+    }
+    searchCells = cells;
+    search = std::async(std::launch::async, [this, cells] { return mesh->solve(cells, searchMoves); });
+  }
+
+  void pollSearch() {
+    if (!search.valid() || search.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return;
+    }
+    const bool found = search.get();
+    const std::vector<int> cells = mesh->boardCells();
+    if (cells != searchCells) {
+      if (playSearch) {
+        startSearch(cells);
+      }
+      return;
+    }
+    solvedCells = searchCells;
+    solvedOk = found;
+    if (!found) {
+      searchMoves.clear();
+    }
+    solvedMoves = searchMoves;
+    if (playSearch) {
+      playSearch = false;
+      solution.assign(solvedMoves.begin(), solvedMoves.end());
+    }
+  }
+
   virtual SwapChain* getSwapChain() {
     // return swapChain;
     return nullptr;
@@ -493,6 +658,7 @@ struct TRenderer : IRenderer {
   Skybox* skybox;
   Entity renderable;
   Engine* engine = nullptr;
+  ResourceCache* resources = nullptr;
   filament::Renderer* filaRenderer = nullptr;
   // SwapChain* swapChain = nullptr;
   Entity cameraEntity;
@@ -525,10 +691,24 @@ struct TRenderer : IRenderer {
   Texture* bgTex;
 
   bool needsDraw = false;
+  bool viewChanged = true;
+  std::unique_ptr<StagingRing> staging;
+  std::unique_ptr<TTileInstances<VB>> instances;
+  Texture* instanceTex = nullptr;
+  std::deque<int> solution;
+  // solver search in flight and the board it started from; only the worker writes searchMoves
+  std::future<bool> search;
+  std::vector<int> searchCells;
+  std::vector<int> searchMoves;
+  bool playSearch = false;
+  // last finished search
+  std::vector<int> solvedCells;
+  std::vector<int> solvedMoves;
+  bool solvedOk = false;
   T* dragTile;
-  math::float3 lastNormalVec;
 
   bool readOnly;
+  bool meshReady = false;
   int winWidth;
   int winHeight;
 
@@ -538,9 +718,15 @@ struct TRenderer : IRenderer {
   static constexpr math::float3 kCameraUp = {0.0f, 1.0f, 0.0f};
   static constexpr float kCameraDist = 1.0f;
   static constexpr double kFieldOfViewDeg = 60.0;
+  // one upload per frame with a few frames in flight on the backend
+  static constexpr int kStagingSlots = 4;
+  // instance texture width, within the smallest GLES 3 texture size limit
+  static constexpr int kMaxInstances = 2048;
   float zoom = 1.f;
 
   static constexpr std::string_view FILAMAT_FILE_UNLIT = "bakedTextureUnlitTransparent.filamat";
+  static constexpr std::string_view FILAMAT_FILE_INSTANCED = "instancedTileUnlitTransparent.filamat";
+  static constexpr std::string_view FILAMAT_FILE_GROUP_DRAG = "groupDragOpaque.filamat";
   static constexpr std::string_view FILAMAT_FILE_MULTI_UNLIT = "multiTextureUnlitTransparent.filamat";
   static constexpr std::string_view FILAMAT_FILE_OPAQUE = "bakedTextureOpaque.filamat";
   static constexpr std::string_view FILAMAT_FILE_LIT = "bakedTextureLitTransparent.filamat";
@@ -5,12 +5,46 @@
 #endif
 
 #include "Vertex.h"
+#include "VertexLayout.h"
+#include <algorithm>
+#include <climits>
 #include <stdlib.h>
 
 namespace tilepuzzles {
 
-template <typename VertexShape, typename IndexShape, int vertsPerShape, int indexPerShape>
+// Shapes [begin, end) written since the last upload. Owned by the vertex buffer and marked by the tiles
+// that write into it, which locate their shape by its address.
+struct DirtyRange {
+  void mark(const void* shape) {
+    const int index = ((const char*)shape - base) / stride;
+    begin = std::min(begin, index);
+    end = std::max(end, index + 1);
+  }
+
+  bool empty() const {
+    return begin >= end;
+  }
+
+  void clear() {
+    begin = INT_MAX;
+    end = 0;
+  }
+
+  const char* base = nullptr;
+  size_t stride = 0;
+  int begin = INT_MAX;
+  int end = 0;
+};
+
+template <typename VertexShape, typename IndexShape, int vertsPerShape, int indexPerShape,
+          typename VertexLayout = DefaultVertexLayout>
 struct TVertexBuffer {
+  using Shape = VertexShape;
+  using Packed = typename VertexLayout::Packed;
+  static constexpr float POSITION_SCALE = VertexLayout::POSITION_SCALE;
+  static constexpr int VERTS_PER_SHAPE = vertsPerShape;
+  static constexpr size_t PACKED_SHAPE_SIZE = sizeof(Packed) * vertsPerShape;
+
     TVertexBuffer(int numVertShapes) : numVertShapes(numVertShapes) {
     vertShapes = (VertexShape*)malloc(numVertShapes * sizeof(VertexShape));
     indexShapes = (IndexShape*)malloc(numVertShapes * sizeof(IndexShape));
@@ -18,6 +52,8 @@ struct TVertexBuffer {
         numIndices = numVertShapes * indexPerShape;
         size = sizeof(VertexShape) * numVertShapes;
         indexSize = sizeof(IndexShape) * numVertShapes;
+    dirty.base = (const char*)vertShapes;
+    dirty.stride = sizeof(VertexShape);
     }
 
     virtual ~TVertexBuffer() {
@@ -53,6 +89,41 @@ struct TVertexBuffer {
         return clonedVertices;
     }
 
+  // Attributes of the uploaded layout.
+  static VertexBuffer::Builder& declare(VertexBuffer::Builder& builder) {
+    return VertexLayout::declare(builder);
+  }
+
+  // Uploaded bytes of the drawn shapes.
+  size_t packedSize() {
+    return getSize() / sizeof(VertexShape) * PACKED_SHAPE_SIZE;
+  }
+
+  // Shapes [begin, end) in the uploaded layout.
+  void pack(int begin, int end, void* dst) const {
+    Packed* packed = (Packed*)dst;
+    for (int s = begin; s < end; ++s) {
+      for (int i = 0; i < vertsPerShape; ++i) {
+        VertexLayout::pack(vertShapes[s][i], *packed++);
+      }
+    }
+  }
+
+  void* clonePacked() {
+    void* packed = malloc(packedSize());
+    pack(0, packedSize() / PACKED_SHAPE_SIZE, packed);
+    return packed;
+  }
+
+  // Uploaded byte range of the dirty shapes, for partial uploads.
+  size_t dirtyOffset() const {
+    return dirty.begin * PACKED_SHAPE_SIZE;
+  }
+
+  size_t dirtySize() const {
+    return dirty.empty() ? 0 : (dirty.end - dirty.begin) * PACKED_SHAPE_SIZE;
+  }
+
   VertexShape* vertShapes;
   IndexShape* indexShapes;
     int numVertShapes = 0;
@@ -60,6 +131,7 @@ struct TVertexBuffer {
     int numIndices = 0;
     size_t size = 0;
     size_t indexSize = 0;
+  DirtyRange dirty;
 #ifdef USE_SDL
     constexpr static Logger L = Logger::getLogger();
 #endif
@@ -0,0 +1,124 @@
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Fixed size work-stealing pool. Each worker has its own deque: it pops its newest task first and, when
+// empty, steals the oldest task of another worker. submit() deals tasks round robin; wait() blocks until
+// every submitted task has run.
+struct ThreadPool {
+  explicit ThreadPool(int threads) : queues(threads < 1 ? 1 : threads) {
+    for (int i = 0; i < queues.size(); ++i) {
+      queues[i].reset(new Queue());
+    }
+    for (int i = 0; i < queues.size(); ++i) {
+      workers.emplace_back([this, i] { run(i); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  int size() const {
+    return queues.size();
+  }
+
+  void submit(std::function<void()> task) {
+    Queue& queue = *queues[nextQueue++ % queues.size()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++pending;
+      ++queued;
+    }
+    workAvailable.notify_one();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool take(int index, std::function<void()>& task) {
+    {
+      Queue& own = *queues[index];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        --queued;
+        return true;
+      }
+    }
+    for (int i = 1; i < queues.size(); ++i) {
+      Queue& victim = *queues[(index + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --queued;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run(int index) {
+    std::function<void()> task;
+    while (true) {
+      if (take(index, task)) {
+        task();
+        task = nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) {
+          allDone.notify_all();
+        }
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      if (stopping) {
+        return;
+      }
+      workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+    }
+  }
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<unsigned> nextQueue{0};
+  std::mutex mutex;
+  std::condition_variable workAvailable;
+  std::condition_variable allDone;
+  std::atomic<int> queued{0};
+  int pending = 0;
+  bool stopping = false;
+};
+
+} // namespace tilepuzzles
+#endif
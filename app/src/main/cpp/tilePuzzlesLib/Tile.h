@@ -7,6 +7,7 @@
 #endif
 
 #include "GameUtil.h"
+#include "TVertexBuffer.h"
 #include "Vertex.h"
 #include "enums.h"
 
@@ -68,6 +69,7 @@ struct Tile {
     (*quadVertices)[1].position = (*other->quadVertices)[1].position;
     (*quadVertices)[2].position = (*other->quadVertices)[2].position;
     (*quadVertices)[3].position = (*other->quadVertices)[3].position;
+    markDirty();
 
     (*iniQuadVertices)[0].position = (*other->iniQuadVertices)[0].position;
     (*iniQuadVertices)[1].position = (*other->iniQuadVertices)[1].position;
@@ -75,13 +77,13 @@ struct Tile {
     (*iniQuadVertices)[3].position = (*other->iniQuadVertices)[3].position;
   }
 
-  virtual bool hasVertex(const math::float2& vert) {
+  virtual bool hasVertex(const math::float2& vert) const {
     return (abs(getVert(0).x - vert.x) <= EPS && abs(getVert(0).y - vert.y) <= EPS) ||
            (abs(getVert(1).x - vert.x) <= EPS && abs(getVert(1).y - vert.y) <= EPS) ||
            (abs(getVert(2).x - vert.x) <= EPS && abs(getVert(2).y - vert.y) <= EPS);
   }
 
-  virtual math::float3 getVert(int index) {
+  virtual math::float3 getVert(int index) const {
     return (*quadVertices)[index].position;
   }  
 
@@ -108,6 +110,7 @@ struct Tile {
 
         // top right
     (*quadVertices)[3].position = {topLeft[0] + size[0], topLeft[1], depth};
+    markDirty();
 
         // logVertices();
 
@@ -120,11 +123,13 @@ struct Tile {
   virtual void updateNormals(const math::float3 norm) {
     (*quadVertices)[0].normal = (*quadVertices)[1].normal = (*quadVertices)[2].normal =
       (*quadVertices)[3].normal = norm;
+    markDirty();
   }
 
     virtual void setVertexZCoord(float zCoord) {
     (*quadVertices)[0].position.z = (*quadVertices)[1].position.z = (*quadVertices)[2].position.z =
         (*quadVertices)[3].position.z = zCoord;
+    markDirty();
     }
 
     virtual void updateTexCoords(int texIndex, float texWidth) {
@@ -139,6 +144,7 @@ struct Tile {
 
         // top right
         (*quadVertices)[3].texCoords = {texWidth * (texIndex + 1), 1};
+    markDirty();
     }
 
     void initVertices(int texIndex, float texWidth) {
@@ -157,6 +163,17 @@ struct Tile {
         (*quadIndicies)[5] = indexOffset + 1;
     }
 
+  // Shape this tile writes in its vertex buffer.
+  virtual const void* shape() const {
+    return quadVertices;
+  }
+
+  void markDirty() {
+    if (dirtyRange) {
+      dirtyRange->mark(shape());
+    }
+  }
+
   Direction directionTo(Tile* other) {
         if (sameColumn(other)) {
             return other->gridCoord.x > gridCoord.x ? Direction::down : Direction::up;
@@ -182,6 +199,7 @@ struct Tile {
   QuadVertices* quadVertices = nullptr;
   QuadIndices* quadIndicies = nullptr;
     QuadVertices* iniQuadVertices = nullptr;
+  DirtyRange* dirtyRange = nullptr;
     Point topLeft;
     Size size;
     std::string tileId;
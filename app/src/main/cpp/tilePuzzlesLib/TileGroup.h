@@ -1,21 +1,48 @@
 #ifndef _TILEGROUP_H_
 #define _TILEGROUP_H_
 
+#include <array>
+#include <stdint.h>
+
 namespace tilepuzzles {
 
+// The tiles around an anchor point, as slots into Mesh::tiles. Plain data, so groups are copied and
+// updated without allocating.
 template <typename T>
 struct TileGroup {
   math::float2 anchorPoint;
-  std::vector<T> tileGroup;
-  bool dragable;
+  std::array<uint16_t, 6> slots;
+  uint8_t count = 0;
+  bool dragable = false;
   math::int2 gridCoord;
-  Tile* anchorTile;
 
   TileGroup() {
   }
 
-  TileGroup(math::float2 anchorPoint, std::vector<T> tileGroup, bool dragable, math::int2 gridCoord)
-    : anchorPoint(anchorPoint), tileGroup(tileGroup), dragable(dragable), gridCoord(gridCoord) {
+  TileGroup(math::float2 anchorPoint, bool dragable, math::int2 gridCoord)
+    : anchorPoint(anchorPoint), dragable(dragable), gridCoord(gridCoord) {
+  }
+
+  int size() const {
+    return count;
+  }
+
+  const uint16_t* begin() const {
+    return slots.data();
+  }
+
+  const uint16_t* end() const {
+    return slots.data() + count;
+  }
+
+  void clear() {
+    count = 0;
+  }
+
+  void add(int slot) {
+    if (count < slots.size()) {
+      slots[count++] = slot;
+    }
   }
 };
 } // namespace tilepuzzles
@@ -0,0 +1,97 @@
+#ifndef _TILE_INSTANCES_H_
+#define _TILE_INSTANCES_H_
+
+#include "TVertexBuffer.h"
+#include "Vertex.h"
+
+#include <math.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+// Placement of one tile on the instanced path, one RGBA32F texel: the tile's solved shape turned by rotation
+// around its center, moved to offset and drawn at depth.
+struct TileInstance {
+  math::float2 offset;
+  float rotation;
+  float depth;
+};
+
+// Static vertex of the instanced path: the corner relative to its tile center in the solved layout, the
+// atlas UV and the index of the tile's instance record.
+struct InstanceVertex {
+  math::float3 corner;
+  math::float2 texCoords;
+  float instance;
+};
+
+// Instance records of the tiles in a vertex buffer. The mesh keeps writing tile vertices; the records of the
+// dirty shapes are derived from them, so moving a tile uploads one 16 byte record instead of its vertices.
+// Tiles only move rigidly, and a slot keeps its atlas index, so the static vertices never change.
+template <typename VB> struct TTileInstances {
+  using Shape = typename VB::Shape;
+  static constexpr int VERTS_PER_SHAPE = VB::VERTS_PER_SHAPE;
+
+  // Takes the solved layout from the buffer, before any move. Shapes past getSize() are never drawn.
+  void init(VB& vertexBuffer) {
+    const int count = vertexBuffer.getSize() / sizeof(Shape);
+    records.resize(count);
+    vertices.resize(count * VERTS_PER_SHAPE);
+    baseAngles.resize(count);
+    for (int s = 0; s < count; ++s) {
+      const Shape& shape = vertexBuffer.vertShapes[s];
+      const math::float2 c = center(shape);
+      baseAngles[s] = angleOf(shape, c);
+      for (int i = 0; i < VERTS_PER_SHAPE; ++i) {
+        vertices[s * VERTS_PER_SHAPE + i] = {
+          {shape[i].position.x - c.x, shape[i].position.y - c.y, 0.F}, shape[i].texCoords, float(s)};
+      }
+      records[s] = place(shape, s);
+    }
+    dirty.base = (const char*)records.data();
+    dirty.stride = sizeof(TileInstance);
+    dirty.clear();
+  }
+
+  // Rederives the records of the shapes written since the last upload.
+  void update(const VB& vertexBuffer, const DirtyRange& written) {
+    const int end = std::min(written.end, int(records.size()));
+    for (int s = written.begin; s < end; ++s) {
+      records[s] = place(vertexBuffer.vertShapes[s], s);
+      dirty.mark(&records[s]);
+    }
+  }
+
+  TileInstance place(const Shape& shape, int s) const {
+    const math::float2 c = center(shape);
+    return {c, angleOf(shape, c) - baseAngles[s], shape[0].position.z};
+  }
+
+  static math::float2 center(const Shape& shape) {
+    math::float2 c = {0.F, 0.F};
+    for (int i = 0; i < VERTS_PER_SHAPE; ++i) {
+      c += shape[i].position.xy;
+    }
+    return c / float(VERTS_PER_SHAPE);
+  }
+
+  static float angleOf(const Shape& shape, const math::float2& c) {
+    return atan2f(shape[0].position.y - c.y, shape[0].position.x - c.x);
+  }
+
+  size_t dirtyOffset() const {
+    return dirty.begin * sizeof(TileInstance);
+  }
+
+  size_t dirtySize() const {
+    return dirty.empty() ? 0 : (dirty.end - dirty.begin) * sizeof(TileInstance);
+  }
+
+  std::vector<TileInstance> records;
+  std::vector<InstanceVertex> vertices;
+  std::vector<float> baseAngles;
+  DirtyRange dirty;
+};
+
+} // namespace tilepuzzles
+#endif
@@ -0,0 +1,84 @@
+#ifndef _TOUCH_QUEUE_H_
+#define _TOUCH_QUEUE_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+namespace tilepuzzles {
+
+static constexpr int ACTION_DOWN = 0;
+static constexpr int ACTION_UP = 1;
+static constexpr int ACTION_MOVE = 2;
+
+struct TouchEvent {
+  int action;
+  float x;
+  float y;
+  int time;
+};
+
+// Single producer, single consumer ring of touch events from the UI thread to the game loop. push() never
+// blocks or allocates; when the game loop has fallen CAPACITY events behind, the event is dropped and
+// counted. drain() runs on the game loop and hands over each run of moves as one path, so a frame drives
+// one drag update per run however fast the panel samples.
+template <uint32_t CAPACITY> struct TTouchQueue {
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two.");
+
+  TTouchQueue() {
+    run.reserve(CAPACITY);
+  }
+
+  bool push(const TouchEvent& event) {
+    const uint32_t back = tail.load(std::memory_order_relaxed);
+    if (back - head.load(std::memory_order_acquire) == CAPACITY) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    events[back & (CAPACITY - 1)] = event;
+    tail.store(back + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Calls handle(const TouchEvent* events, int count) in order, once per press or release and once per run
+  // of moves with the whole run; returns the number of calls.
+  template <typename F> int drain(F handle) {
+    uint32_t front = head.load(std::memory_order_relaxed);
+    const uint32_t back = tail.load(std::memory_order_acquire);
+    int handled = 0;
+    run.clear();
+    for (; front != back; ++front) {
+      const TouchEvent event = events[front & (CAPACITY - 1)];
+      if (event.action == ACTION_MOVE) {
+        coalesced += !run.empty();
+        run.push_back(event);
+        continue;
+      }
+      if (!run.empty()) {
+        handle(run.data(), int(run.size()));
+        run.clear();
+        ++handled;
+      }
+      handle(&event, 1);
+      ++handled;
+    }
+    if (!run.empty()) {
+      handle(run.data(), int(run.size()));
+      ++handled;
+    }
+    head.store(front, std::memory_order_release);
+    return handled;
+  }
+
+  alignas(64) std::atomic<uint32_t> head{0};
+  alignas(64) std::atomic<uint32_t> tail{0};
+  std::atomic<int> dropped{0};
+  int coalesced = 0;
+  std::vector<TouchEvent> run;
+  TouchEvent events[CAPACITY];
+};
+
+using TouchQueue = TTouchQueue<256>;
+
+} // namespace tilepuzzles
+#endif
@@ -0,0 +1,78 @@
+#ifndef _VERTEX_LAYOUT_H_
+#define _VERTEX_LAYOUT_H_
+
+#include "Vertex.h"
+
+#include <filament/VertexBuffer.h>
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+
+namespace tilepuzzles {
+
+// GPU side vertex formats. Tiles always write Vertex; a layout packs it for upload and declares the matching
+// VertexBuffer attributes. The normal only carries the anchor flag, read by materials as CUSTOM0.
+
+// The Vertex as written, 32 bytes.
+struct FullVertexLayout {
+  using Packed = Vertex;
+  static constexpr float POSITION_SCALE = 1.F;
+
+  static void pack(const Vertex& vertex, Packed& packed) {
+    packed = vertex;
+  }
+
+  static VertexBuffer::Builder& declare(VertexBuffer::Builder& builder) {
+    return builder.attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3, 0, sizeof(Packed))
+      .attribute(VertexAttribute::CUSTOM0, 0, VertexBuffer::AttributeType::FLOAT3, 12, sizeof(Packed))
+      .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::FLOAT2, 24, sizeof(Packed));
+  }
+};
+
+// 12 bytes: int16 normalized position, 8 bit flags, 16 bit normalized UV. Depths and atlas UVs lie in [-1, 1]
+// and [0, 1]. The board does too at rest, but a group turned around an anchor near the edge swings its corners
+// out by up to a tile, so x and y are stored divided by POSITION_SCALE and the renderer scales them back with
+// the renderable's transform. Anything outside is clamped.
+struct CompactVertexLayout {
+  static constexpr float POSITION_SCALE = 2.F;
+
+  struct Packed {
+    int16_t position[3];
+    uint8_t flags;
+    uint8_t pad;
+    uint16_t texCoords[2];
+  };
+  static_assert(sizeof(Packed) == 12, "Strange compact vertex size.");
+
+  static void pack(const Vertex& vertex, Packed& packed) {
+    for (int i = 0; i < 3; ++i) {
+      const float scaled = i < 2 ? vertex.position[i] / POSITION_SCALE : vertex.position[i];
+      packed.position[i] = lroundf(std::clamp(scaled, -1.F, 1.F) * INT16_MAX);
+    }
+    packed.flags = vertex.normal.x != 0.F ? UINT8_MAX : 0;
+    packed.pad = 0;
+    for (int i = 0; i < 2; ++i) {
+      packed.texCoords[i] = lroundf(std::clamp(vertex.texCoords[i], 0.F, 1.F) * UINT16_MAX);
+    }
+  }
+
+  static VertexBuffer::Builder& declare(VertexBuffer::Builder& builder) {
+    return builder.attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::SHORT3, 0, sizeof(Packed))
+      .normalized(VertexAttribute::POSITION)
+      .attribute(VertexAttribute::CUSTOM0, 0, VertexBuffer::AttributeType::UBYTE, 6, sizeof(Packed))
+      .normalized(VertexAttribute::CUSTOM0)
+      .attribute(VertexAttribute::UV0, 0, VertexBuffer::AttributeType::USHORT2, 8, sizeof(Packed))
+      .normalized(VertexAttribute::UV0);
+  }
+};
+
+// Build with COMPACT_VERTICES to upload the compact layout.
+#ifdef COMPACT_VERTICES
+using DefaultVertexLayout = CompactVertexLayout;
+#else
+using DefaultVertexLayout = FullVertexLayout;
+#endif
+
+} // namespace tilepuzzles
+#endif
@@ -53,6 +53,10 @@ void touchAction(int action, float x, float y) {
     app.touchAction(action, x, y);
 }
 
+void touchActions(const TouchSample *samples, int count) {
+    app.touchActions(samples, count);
+}
+
 void render() {}
 
 void destroySwapChain() {
@@ -70,3 +74,11 @@ void resizeWindow(int width, int height) {
 void shuffle() {
     app.renderer->shuffle();
 }
+
+int solve() {
+    return app.renderer->solve();
+}
+
+int hint() {
+    return app.renderer->hint();
+}
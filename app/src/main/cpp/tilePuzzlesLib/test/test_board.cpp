@@ -0,0 +1,613 @@
+#define CATCH_CONFIG_PREFIX_ALL
+#include "SliderMesh.h"
+#include "RollerMesh.h"
+#include "HexSpinMesh.h"
+#include "BoardState.h"
+#include "EtcCodec.h"
+#include "SliderScrambler.h"
+#include "SliderSolver.h"
+#include "StagingRing.h"
+#include "TileInstances.h"
+#include "TouchQueue.h"
+#include "GLogger.h"
+#include "TestUtil.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <map>
+
+using namespace tilepuzzles;
+
+template <typename M>
+static bool tilesMatchBoard(M& mesh) {
+  mesh.updateGeometry();
+  for (auto& tile : mesh.tiles) {
+    if (mesh.tileAt(tile.gridCoord.x, tile.gridCoord.y) != &tile) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The buffers hex moves reuse between touch events, as data pointer and capacity: a move that allocated
+// would have grown one of them.
+static std::vector<std::pair<const void*, size_t>> scratchBuffers(const HexSpinMesh& mesh) {
+  return {{mesh.movedSlots.data(), mesh.movedSlots.capacity()},
+          {mesh.touchedAnchors.data(), mesh.touchedAnchors.capacity()},
+          {mesh.board.dirtyCells.data(), mesh.board.dirtyCells.capacity()}};
+}
+
+// Every anchor group holds exactly the tiles touching its anchor point.
+static bool groupsMatchTiles(HexSpinMesh& mesh) {
+  mesh.processAnchorGroups();
+  for (const auto& group : mesh.tileGroupAnchors) {
+    int count = 0;
+    for (const auto& tile : mesh.tiles) {
+      count += tile.hasVertex(group.anchorPoint);
+    }
+    if (count != group.size()) {
+      return false;
+    }
+    for (int slot : group) {
+      if (!mesh.tiles[slot].hasVertex(group.anchorPoint)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+CATCH_TEST_CASE("BoardState", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+
+  BoardState board;
+  board.init(3, 4);
+  CATCH_REQUIRE(board.size() == 12);
+  CATCH_REQUIRE(board.isSolved());
+  CATCH_REQUIRE(!board.isDirty());
+
+  CATCH_SECTION("swap keeps cells and slots inverse") {
+    board.swapCells(board.cell(0, 1), board.cell(2, 3));
+    CATCH_REQUIRE(!board.isSolved());
+    CATCH_REQUIRE(board.tileAt(board.cell(2, 3)) == 1);
+    CATCH_REQUIRE(board.cellOf(1) == board.cell(2, 3));
+    CATCH_REQUIRE(board.cellOf(11) == 1);
+
+    std::vector<int> flushed;
+    board.flushDirty([&flushed](int cell) { flushed.push_back(cell); });
+    CATCH_REQUIRE(flushed.size() == 2);
+    CATCH_REQUIRE(!board.isDirty());
+
+    board.swapCells(board.cell(0, 1), board.cell(2, 3));
+    CATCH_REQUIRE(board.isSolved());
+  }
+
+  CATCH_SECTION("turned tile is not solved") {
+    board.place(5, 5, 1);
+    CATCH_REQUIRE(!board.isSolved());
+  }
+}
+
+CATCH_TEST_CASE("SliderScrambler", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+  SliderScrambler scrambler(7);
+
+  CATCH_SECTION("boards are solvable permutations") {
+    for (int dim = 2; dim <= 8; ++dim) {
+      uint16_t cells[64];
+      for (int i = 0; i < 200; ++i) {
+        scrambler.scramble(dim, cells);
+        std::vector<int> board(cells, cells + dim * dim);
+        std::vector<int> sorted = board;
+        std::sort(sorted.begin(), sorted.end());
+        for (int t = 0; t < sorted.size(); ++t) {
+          CATCH_REQUIRE(sorted[t] == t);
+        }
+        CATCH_REQUIRE(SliderSolver::isSolvable(board, dim));
+      }
+    }
+  }
+
+  CATCH_SECTION("20x20 and the largest boards") {
+    for (int dim : {20, SliderScrambler::MAX_DIM}) {
+      std::vector<uint16_t> cells(dim * dim);
+      for (int i = 0; i < 3; ++i) {
+        scrambler.scramble(dim, cells.data());
+        std::vector<int> board(cells.begin(), cells.end());
+        std::vector<int> sorted = board;
+        std::sort(sorted.begin(), sorted.end());
+        for (int t = 0; t < sorted.size(); ++t) {
+          CATCH_REQUIRE(sorted[t] == t);
+        }
+        if (dim == 20) {
+          CATCH_REQUIRE(SliderSolver::isSolvable(board, dim));
+        }
+        // isSolvable counts inversions, too slow here: parity from the cycles against the blank's distance
+        std::vector<bool> seen(board.size());
+        int cycles = 0;
+        int blank = 0;
+        for (int c = 0; c < board.size(); ++c) {
+          blank = board[c] == board.size() - 1 ? c : blank;
+          cycles += !seen[c];
+          for (int j = c; !seen[j]; j = board[j]) {
+            seen[j] = true;
+          }
+        }
+        const int blankDistance = (dim - 1 - blank / dim) + (dim - 1 - blank % dim);
+        CATCH_REQUIRE((board.size() - cycles) % 2 == blankDistance % 2);
+      }
+    }
+  }
+
+  CATCH_SECTION("every 2x2 board is equally likely") {
+    std::map<std::vector<int>, int> counts;
+    uint16_t cells[4];
+    const int samples = 120000;
+    for (int i = 0; i < samples; ++i) {
+      scrambler.scramble(2, cells);
+      ++counts[std::vector<int>(cells, cells + 4)];
+    }
+    CATCH_REQUIRE(counts.size() == 12);
+    for (const auto& count : counts) {
+      CATCH_REQUIRE(abs(count.second - samples / 12) < samples / 120);
+    }
+  }
+}
+
+CATCH_TEST_CASE("StagingRing", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+  StagingRing ring(3, 64);
+  const char bytes[64] = "staged";
+  void* users[4] = {};
+
+  for (int i = 0; i < 3; ++i) {
+    void* block = ring.acquire(sizeof(bytes), users[i]);
+    CATCH_REQUIRE(block != nullptr);
+    memcpy(block, bytes, sizeof(bytes));
+  }
+  CATCH_REQUIRE(ring.acquire(8, users[3]) == nullptr);
+  CATCH_REQUIRE(ring.acquire(128, users[3]) == nullptr);
+  CATCH_REQUIRE(ring.overflows == 2);
+  CATCH_REQUIRE(ring.highWater == 3);
+
+  // the backend hands slots back, dragging then cycles through them
+  void* released = ((StagingRing::Slot*)users[1])->data;
+  StagingRing::release(released, 64, users[1]);
+  CATCH_REQUIRE(ring.acquire(8, users[1]) == released);
+  for (int i = 0; i < 3; ++i) {
+    StagingRing::release(nullptr, 64, users[i]);
+  }
+  for (int i = 0; i < 100; ++i) {
+    CATCH_REQUIRE(ring.acquire(8, users[0]) != nullptr);
+    StagingRing::release(nullptr, 8, users[0]);
+  }
+  CATCH_REQUIRE(ring.inFlight == 0);
+  CATCH_REQUIRE(ring.highWater == 3);
+  CATCH_REQUIRE(ring.overflows == 2);
+}
+
+CATCH_TEST_CASE("TouchQueue", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+
+  CATCH_SECTION("moves between presses are handed over as one path") {
+    TTouchQueue<16> queue;
+    queue.push({ACTION_DOWN, 1, 1, 0});
+    for (int i = 0; i < 4; ++i) {
+      queue.push({ACTION_MOVE, float(i), 0, i});
+    }
+    queue.push({ACTION_UP, 5, 5, 5});
+    queue.push({ACTION_MOVE, 6, 0, 6});
+    queue.push({ACTION_MOVE, 7, 0, 7});
+    std::vector<std::vector<TouchEvent>> handled;
+    CATCH_REQUIRE(queue.drain([&](const TouchEvent* events, int count) {
+      handled.emplace_back(events, events + count);
+    }) == 4);
+    CATCH_REQUIRE(handled.size() == 4);
+    CATCH_REQUIRE((handled[0].size() == 1 && handled[0][0].action == ACTION_DOWN));
+    CATCH_REQUIRE(handled[1].size() == 4);
+    for (int i = 0; i < 4; ++i) {
+      CATCH_REQUIRE((handled[1][i].action == ACTION_MOVE && handled[1][i].x == i && handled[1][i].time == i));
+    }
+    CATCH_REQUIRE((handled[2].size() == 1 && handled[2][0].action == ACTION_UP));
+    CATCH_REQUIRE((handled[3].size() == 2 && handled[3][1].x == 7));
+    CATCH_REQUIRE(queue.coalesced == 4);
+    CATCH_REQUIRE(queue.drain([](const TouchEvent*, int) {}) == 0);
+  }
+
+  CATCH_SECTION("a path that wraps the ring stays in order") {
+    TTouchQueue<4> queue;
+    queue.push({ACTION_DOWN, 0, 0, 0});
+    queue.push({ACTION_UP, 0, 0, 0});
+    queue.push({ACTION_DOWN, 0, 0, 0});
+    queue.drain([](const TouchEvent*, int) {});
+    for (int i = 0; i < 4; ++i) {
+      queue.push({ACTION_MOVE, float(i), 0, i});
+    }
+    std::vector<float> path;
+    CATCH_REQUIRE(queue.drain([&](const TouchEvent* events, int count) {
+      for (int i = 0; i < count; ++i) {
+        path.push_back(events[i].x);
+      }
+    }) == 1);
+    CATCH_REQUIRE(path == std::vector<float>{0, 1, 2, 3});
+  }
+
+  CATCH_SECTION("a full ring drops instead of blocking") {
+    TTouchQueue<4> queue;
+    for (int i = 0; i < 6; ++i) {
+      queue.push({ACTION_DOWN, float(i), 0, 0});
+    }
+    CATCH_REQUIRE(queue.dropped == 2);
+    float last = -1;
+    CATCH_REQUIRE(queue.drain([&](const TouchEvent* events, int) { last = events[0].x; }) == 4);
+    CATCH_REQUIRE(last == 3);
+  }
+
+  CATCH_SECTION("a UI thread and the game loop") {
+    TTouchQueue<64> queue;
+    const int presses = 20000;
+    std::thread ui([&] {
+      for (int i = 0; i < presses;) {
+        if (queue.push({ACTION_DOWN, float(i), 0, 0})) {
+          ++i;
+        }
+      }
+    });
+    int received = 0;
+    bool ordered = true;
+    while (received < presses) {
+      queue.drain([&](const TouchEvent* events, int count) {
+        for (int i = 0; i < count; ++i) {
+          ordered &= events[i].x == received;
+          ++received;
+        }
+      });
+    }
+    ui.join();
+    CATCH_REQUIRE(ordered);
+  }
+}
+
+CATCH_TEST_CASE("VertexLayout", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+  using CompactQuads = TVertexBuffer<QuadVertices, QuadIndices, 4, 6, CompactVertexLayout>;
+  CATCH_REQUIRE(TVertexBuffer<QuadVertices, QuadIndices, 4, 6, FullVertexLayout>::PACKED_SHAPE_SIZE == 128);
+  CATCH_REQUIRE(CompactQuads::PACKED_SHAPE_SIZE == 48);
+
+  const Vertex vertex = {{-.3125F, .75F, GameUtil::RAISED_TILE_DEPTH}, {1.F, 1.F, 1.F}, {.0625F, 1.F}};
+  CompactVertexLayout::Packed packed;
+  CompactVertexLayout::pack(vertex, packed);
+  const float scales[3] = {CompactVertexLayout::POSITION_SCALE, CompactVertexLayout::POSITION_SCALE, 1.F};
+  for (int i = 0; i < 3; ++i) {
+    CATCH_REQUIRE(abs(packed.position[i] * scales[i] / float(INT16_MAX) - vertex.position[i]) < 1e-4F);
+  }
+  for (int i = 0; i < 2; ++i) {
+    CATCH_REQUIRE(abs(packed.texCoords[i] / float(UINT16_MAX) - vertex.texCoords[i]) < 1e-4F);
+  }
+  CATCH_REQUIRE(packed.flags == UINT8_MAX);
+
+  // a corner swung off the board by a group turn keeps its place
+  Vertex turned = vertex;
+  turned.position = {-1.4F, 1.2F, GameUtil::RAISED_TILE_DEPTH};
+  CompactVertexLayout::Packed packedTurned;
+  CompactVertexLayout::pack(turned, packedTurned);
+  for (int i = 0; i < 2; ++i) {
+    CATCH_REQUIRE(abs(packedTurned.position[i] * scales[i] / float(INT16_MAX) - turned.position[i]) < 1e-4F);
+  }
+
+  CompactQuads compact(2);
+  for (int i = 0; i < 4; ++i) {
+    compact.get(1)[i] = vertex;
+  }
+  compact.dirty.mark(&compact.get(1));
+  CATCH_REQUIRE(compact.dirtyOffset() == 48);
+  CATCH_REQUIRE(compact.dirtySize() == 48);
+  CompactVertexLayout::Packed shape[4];
+  compact.pack(compact.dirty.begin, compact.dirty.end, shape);
+  CATCH_REQUIRE(memcmp(&shape[3], &packed, sizeof(packed)) == 0);
+}
+
+CATCH_TEST_CASE("EtcCodec", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+  uint8_t texels[64];
+
+  // individual mode, zero bases, table 0, every texel +2
+  EtcCodec::decodeColor(0, texels);
+  CATCH_REQUIRE((texels[0] == 2 && texels[61] == 2 && texels[62] == 2));
+  // differential mode, white base, every texel -8
+  EtcCodec::decodeColor(uint64_t(31) << 59 | uint64_t(31) << 51 | uint64_t(31) << 43 | uint64_t(1) << 33 | 0xFFFFFFFF,
+                        texels);
+  CATCH_REQUIRE((texels[0] == 247 && texels[61] == 247 && texels[62] == 247));
+
+  // a smooth color ramp with an alpha ramp, and an uneven size
+  const int width = 18;
+  const int height = 9;
+  std::vector<uint8_t> rgba(width * height * 4);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      uint8_t* texel = &rgba[(y * width + x) * 4];
+      texel[0] = 40 + x * 8;
+      texel[1] = 200 - y * 10;
+      texel[2] = 90 + x * 2 + y * 3;
+      texel[3] = x * 15;
+    }
+  }
+  for (bool alpha : {false, true}) {
+    const std::vector<uint8_t> blocks = EtcCodec::encode(rgba.data(), width, height, alpha);
+    CATCH_REQUIRE(blocks.size() == 5 * 3 * EtcCodec::blockSize(alpha));
+    const std::vector<uint8_t> decoded = EtcCodec::decode(blocks.data(), width, height, alpha);
+    int colorError = 0;
+    int alphaError = 0;
+    for (int i = 0; i < rgba.size(); ++i) {
+      const int d = abs(int(decoded[i]) - rgba[i]);
+      if (i % 4 == 3) {
+        alphaError = std::max(alphaError, d);
+      } else if (rgba[i / 4 * 4 + 3] != 0 || !alpha) {
+        colorError = std::max(colorError, d);
+      }
+    }
+    CATCH_REQUIRE(colorError <= 16);
+    CATCH_REQUIRE(alphaError <= (alpha ? 2 : 255));
+  }
+}
+
+// Instance records applied to the static corners land on the tile vertices.
+template <typename VB, typename M> static bool instancesMatchVertices(M& mesh, TTileInstances<VB>& instances) {
+  mesh.updateGeometry();
+  instances.update(*mesh.vertexBuffer, mesh.vertexBuffer->dirty);
+  mesh.vertexBuffer->dirty.clear();
+  for (int s = 0; s < instances.records.size(); ++s) {
+    const TileInstance& record = instances.records[s];
+    for (int i = 0; i < VB::VERTS_PER_SHAPE; ++i) {
+      const math::float3 corner = instances.vertices[s * VB::VERTS_PER_SHAPE + i].corner;
+      const float c = cosf(record.rotation);
+      const float sn = sinf(record.rotation);
+      const math::float3 placed = {c * corner.x - sn * corner.y + record.offset.x,
+                                   sn * corner.x + c * corner.y + record.offset.y, record.depth};
+      if (GeoUtil::tdist(placed, mesh.vertexBuffer->get(s)[i].position) > Tile::EPS) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+CATCH_TEST_CASE("TileInstances", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+
+  CATCH_SECTION("slider") {
+    SliderMesh mesh;
+    mesh.init(R"({"type":"slider","dimension":{"count":16},"render":{"instanced":true}})");
+    CATCH_REQUIRE(mesh.renderInstanced());
+    mesh.updateGeometry();
+    TTileInstances<TQuadVertexBuffer> instances;
+    instances.init(*mesh.vertexBuffer);
+    instances.dirty.clear();
+    mesh.slideTiles(mesh.tiles[mesh.board.tileAt(14)]);
+    CATCH_REQUIRE(instancesMatchVertices<TQuadVertexBuffer>(mesh, instances));
+    CATCH_REQUIRE(instances.dirtySize() == 2 * sizeof(TileInstance));
+    mesh.shuffle();
+    CATCH_REQUIRE(instancesMatchVertices<TQuadVertexBuffer>(mesh, instances));
+  }
+
+  CATCH_SECTION("hex turns, rolls and drags") {
+    HexSpinMesh mesh;
+    mesh.init(R"({"type":"HexSpinner","dimension":{"rows":3,"columns":3}})");
+    CATCH_REQUIRE(!mesh.renderInstanced());
+    mesh.updateGeometry();
+    TTileInstances<TriangleVertexBuffer> instances;
+    instances.init(*mesh.vertexBuffer);
+    for (int i = 0; i < 30; ++i) {
+      mesh.turnTileGroup(mesh.tileGroupAnchors[rand() % mesh.tileGroupAnchors.size()], rand() % 2 ? 1 : -1);
+      mesh.rollTileGroups(*mesh.tileGroupAt(rand() % 3, rand() % 3), (Direction)(rand() % 4));
+      CATCH_REQUIRE(instancesMatchVertices<TriangleVertexBuffer>(mesh, instances));
+    }
+    TileGroup<HexTile> drag = mesh.tileGroupAnchors[4];
+    mesh.setTileGroupZCoord(drag, GameUtil::RAISED_TILE_DEPTH);
+    mesh.rotateTileGroup(drag, .3F);
+    CATCH_REQUIRE(instancesMatchVertices<TriangleVertexBuffer>(mesh, instances));
+    mesh.poseTileGroup(drag, -1.1F);
+    CATCH_REQUIRE(instancesMatchVertices<TriangleVertexBuffer>(mesh, instances));
+  }
+}
+
+CATCH_TEST_CASE("MeshBoard", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+
+  CATCH_SECTION("slider") {
+    SliderMesh mesh;
+    mesh.init(R"({"type":"slider","dimension":{"count":16}})");
+    for (int i = 0; i < 500; ++i) {
+      mesh.slideTiles(mesh.tiles[rand() % mesh.tiles.size()]);
+    }
+    CATCH_REQUIRE(tilesMatchBoard(mesh));
+    mesh.shuffle();
+    CATCH_REQUIRE(tilesMatchBoard(mesh));
+    std::vector<int> moves;
+    CATCH_REQUIRE(mesh.solve(moves));
+  }
+
+  CATCH_SECTION("a slide dirties only the moved shapes") {
+    SliderMesh mesh;
+    mesh.init(R"({"type":"slider","dimension":{"count":64}})");
+    mesh.updateGeometry();
+    mesh.vertexBuffer->dirty.clear();
+    mesh.slideTiles(mesh.tiles[mesh.board.tileAt(62)]);
+    mesh.updateGeometry();
+    CATCH_REQUIRE(mesh.vertexBuffer->dirtyOffset() == 62 * TQuadVertexBuffer::PACKED_SHAPE_SIZE);
+    CATCH_REQUIRE(mesh.vertexBuffer->dirtySize() == 2 * TQuadVertexBuffer::PACKED_SHAPE_SIZE);
+    mesh.vertexBuffer->dirty.clear();
+    CATCH_REQUIRE(mesh.vertexBuffer->dirtySize() == 0);
+  }
+
+  CATCH_SECTION("roller row and column are cyclic") {
+    RollerMesh mesh;
+    mesh.init(R"({"type":"roller","dimension":{"count":25}})");
+    for (int i = 0; i < 5; ++i) {
+      mesh.rollTiles(*mesh.tileAt(2, 0), Direction::right);
+    }
+    CATCH_REQUIRE(mesh.board.isSolved());
+    mesh.rollTiles(*mesh.tileAt(0, 3), Direction::up);
+    CATCH_REQUIRE(mesh.gridCoordOf(mesh.tiles[mesh.board.cell(0, 3)]) == math::int2({4, 3}));
+    mesh.rollTiles(*mesh.tileAt(0, 3), Direction::down);
+    CATCH_REQUIRE(mesh.board.isSolved());
+    CATCH_REQUIRE(tilesMatchBoard(mesh));
+  }
+
+  CATCH_SECTION("lattice hit tests agree with the tile shapes") {
+    HexSpinMesh hex;
+    hex.init(R"({"type":"HexSpinner","dimension":{"rows":3,"columns":3}})");
+    hex.shuffle();
+    RollerMesh roller;
+    roller.init(R"({"type":"roller","dimension":{"count":25}})");
+    roller.rollTiles(*roller.tileAt(1, 1), Direction::right);
+    for (int i = 0; i < 5000; ++i) {
+      // a point well inside one hex tile, away from the edges its shape test is lenient about
+      HexTile& tile = hex.tiles[rand() % hex.tiles.size()];
+      const math::float3 w = {GameUtil::frand(.05F, 1.F), GameUtil::frand(.05F, 1.F), GameUtil::frand(.05F, 1.F)};
+      const math::float3 inside = (w.x * tile.getVert(0) + w.y * tile.getVert(1) + w.z * tile.getVert(2)) /
+                                  (w.x + w.y + w.z);
+      CATCH_REQUIRE(tile.onClick({inside.x, inside.y}));
+      CATCH_REQUIRE(hex.hitTest(inside) == &tile);
+
+      const math::float3 point = {GameUtil::frand(-1.1F, 1.1F), GameUtil::frand(-1.1F, 1.1F), 0.F};
+      const Tile* square = nullptr;
+      for (const Tile& t : roller.tiles) {
+        if (t.onClick({point.x, point.y})) {
+          square = &t;
+        }
+      }
+      CATCH_REQUIRE(roller.hitTest(point) == square);
+    }
+    CATCH_REQUIRE(hex.hitTest({1.05F, 0.F, 0.F}) == nullptr);
+    for (const auto& group : hex.tileGroupAnchors) {
+      const math::float3 near = {group.anchorPoint.x + GeoUtil::EPS, group.anchorPoint.y - GeoUtil::EPS, 0.F};
+      CATCH_REQUIRE(hex.hitTestAnchor(near) == &group);
+      CATCH_REQUIRE(hex.anchorIndexOf(group.anchorPoint) == &group - hex.tileGroupAnchors.data());
+    }
+    CATCH_REQUIRE(hex.hitTestAnchor({.5F * hex.tiles[0].size.x - 1.F, .5F, 0.F}) == nullptr);
+  }
+}
+
+CATCH_TEST_CASE("HexSpinMesh", "[board]") {
+  tilepuzzles::TestUtil::init_test();
+
+  HexSpinMesh mesh;
+  mesh.init(R"({"type":"HexSpinner","dimension":{"rows":3,"columns":3}})");
+  CATCH_REQUIRE(mesh.anchorCells.size() == mesh.tileGroupAnchors.size());
+  for (const auto& cells : mesh.anchorCells) {
+    CATCH_REQUIRE(cells.size() == 6);
+  }
+
+  CATCH_SECTION("six turns bring a group back") {
+    const auto anchor = mesh.tileGroupAnchors[4];
+    mesh.turnTileGroup(anchor, 1);
+    CATCH_REQUIRE(!mesh.board.isSolved());
+    for (int i = 0; i < 5; ++i) {
+      mesh.turnTileGroup(anchor, 1);
+    }
+    CATCH_REQUIRE(mesh.board.isSolved());
+
+    mesh.turnTileGroup(anchor, 2);
+    mesh.turnTileGroup(anchor, -2);
+    CATCH_REQUIRE(mesh.board.isSolved());
+  }
+
+  CATCH_SECTION("a roll and its opposite cancel") {
+    TileGroup<HexTile> group = *mesh.tileGroupAt(0, 0);
+    mesh.turnTileGroup(group, 1);
+    mesh.rollTileGroups(group, Direction::right);
+    mesh.rollTileGroups(*mesh.tileGroupAt(0, 0), Direction::left);
+    mesh.turnTileGroup(group, -1);
+    CATCH_REQUIRE(mesh.board.isSolved());
+  }
+
+  CATCH_SECTION("a drag that snaps back redraws the group at rest") {
+    TileGroup<HexTile> dragged = mesh.tileGroupAnchors[4];
+    mesh.setTileGroupZCoord(dragged, GameUtil::RAISED_TILE_DEPTH);
+    mesh.rotateTileGroup(dragged, .3F);
+    mesh.turnTileGroup(dragged, 6);
+    CATCH_REQUIRE(mesh.board.isSolved());
+    for (int cell : mesh.anchorCells[4]) {
+      const math::float3 corner = (*mesh.tiles[cell].triangleVertices)[0].position;
+      CATCH_REQUIRE(corner == mesh.cellCorners[cell][0]);
+      CATCH_REQUIRE(corner.z == GameUtil::TILE_DEPTH);
+    }
+  }
+
+  CATCH_SECTION("groups follow random turns and rolls") {
+    for (int i = 0; i < 50; ++i) {
+      mesh.turnTileGroup(mesh.tileGroupAnchors[rand() % mesh.tileGroupAnchors.size()], rand() % 2 ? 1 : -1);
+      mesh.rollTileGroups(*mesh.tileGroupAt(rand() % 3, rand() % 3), (Direction)(rand() % 4));
+    }
+    CATCH_REQUIRE(groupsMatchTiles(mesh));
+  }
+
+  CATCH_SECTION("a sixth of a turn posed lands where a turn puts the tiles") {
+    // turned tiles first, so the rest corners are not all at turn 0
+    mesh.turnTileGroup(mesh.tileGroupAnchors[3], 1);
+    mesh.turnTileGroup(mesh.tileGroupAnchors[5], -1);
+    CATCH_REQUIRE(groupsMatchTiles(mesh));
+
+    // any number of poses back to zero leave the corners exact
+    TileGroup<HexTile> posed = mesh.tileGroupAnchors[4];
+    for (int i = 0; i < 1000; ++i) {
+      mesh.poseTileGroup(posed, .01F * i);
+    }
+    mesh.poseTileGroup(posed, GeoUtil::PI_3);
+    std::vector<std::pair<int, math::float3>> turned;
+    for (int slot : posed) {
+      turned.push_back({slot, (*mesh.tiles[slot].triangleVertices)[0].position});
+    }
+    mesh.poseTileGroup(posed, 0.F);
+    for (int cell : mesh.anchorCells[4]) {
+      const int turn = mesh.board.turnAt(cell);
+      const math::float3 corner = (*mesh.tiles[mesh.board.tileAt(cell)].triangleVertices)[0].position;
+      CATCH_REQUIRE(corner == mesh.cellCorners[cell][turn % 3]);
+    }
+    mesh.turnTileGroup(posed, 1);
+    for (const auto& [slot, corner] : turned) {
+      CATCH_REQUIRE(GeoUtil::tdist(corner, (*mesh.tiles[slot].triangleVertices)[0].position) < HexTile::EPS);
+    }
+  }
+
+  CATCH_SECTION("a GPU drag only flags the group's vertices") {
+    // the turn on release commits the geometry
+    TileGroup<HexTile> flagged = mesh.tileGroupAnchors[2];
+    mesh.setTileGroupDragged(flagged, true);
+    for (int slot : flagged) {
+      CATCH_REQUIRE((*mesh.tiles[slot].triangleVertices)[1].normal.x == 1.F);
+    }
+    mesh.setTileGroupDragged(flagged, false);
+    mesh.turnTileGroup(flagged, 2);
+    for (const HexTile& tile : mesh.tiles) {
+      CATCH_REQUIRE((*tile.triangleVertices)[0].normal.x == 0.F);
+    }
+    CATCH_REQUIRE(groupsMatchTiles(mesh));
+  }
+
+  CATCH_SECTION("touch events reuse the scratch buffers") {
+    // what HexSpinRenderer does per touch event; the first pass sizes the scratch buffers
+    const auto touchEvents = [&mesh] {
+      for (int i = 0; i < 20; ++i) {
+        TileGroup<HexTile> drag = *mesh.nearestAnchorGroup({.1F * (i % 5), -.1F * (i % 7)});
+        mesh.hitTest({.05F * i, .05F * i, 0.});
+        mesh.setTileGroupZCoord(drag, GameUtil::RAISED_TILE_DEPTH);
+        mesh.poseTileGroup(drag, .05F * i);
+        mesh.turnTileGroup(drag, i % 3 - 1);
+        mesh.setTileGroupZCoord(drag, GameUtil::TILE_DEPTH);
+        mesh.rollTileGroups(*mesh.tileGroupAt(i % 3, (i / 3) % 3), (Direction)(i % 4));
+      }
+    };
+    touchEvents();
+    const auto scratch = scratchBuffers(mesh);
+    touchEvents();
+    CATCH_REQUIRE(scratchBuffers(mesh) == scratch);
+    CATCH_REQUIRE(groupsMatchTiles(mesh));
+  }
+
+  CATCH_SECTION("shuffle keeps tiles on the board") {
+    mesh.shuffle();
+    CATCH_REQUIRE(tilesMatchBoard(mesh));
+    CATCH_REQUIRE(groupsMatchTiles(mesh));
+  }
+}
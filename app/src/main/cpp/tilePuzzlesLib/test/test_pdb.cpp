@@ -0,0 +1,151 @@
+#define CATCH_CONFIG_PREFIX_ALL
+#include "PatternDatabase.h"
+#include "PatternDatabaseBuilder.h"
+#include "SliderSolver.h"
+#include "GLogger.h"
+#include "TestUtil.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <set>
+
+using namespace tilepuzzles;
+
+static std::vector<int> randomWalk(int dim, int length) {
+  std::vector<int> cells(dim * dim);
+  for (int i = 0; i < cells.size(); ++i) {
+    cells[i] = i;
+  }
+  int blank = cells.size() - 1;
+  for (int i = 0; i < length; ++i) {
+    const int moves[] = {blank - dim, blank + dim, blank % dim ? blank - 1 : -1,
+                         blank % dim < dim - 1 ? blank + 1 : -1};
+    const int to = moves[rand() % 4];
+    if (to >= 0 && to < cells.size()) {
+      std::swap(cells[blank], cells[to]);
+      blank = to;
+    }
+  }
+  return cells;
+}
+
+static std::vector<uint8_t> positionsOf(const std::vector<int>& cells) {
+  std::vector<uint8_t> positions(cells.size());
+  for (int cell = 0; cell < cells.size(); ++cell) {
+    positions[cells[cell]] = cell;
+  }
+  return positions;
+}
+
+static bool buildDatabase(const std::string& path, int dim, const std::vector<int>& sizes) {
+  const auto patterns = PatternDatabaseBuilder::partition(dim, sizes);
+  std::vector<std::vector<uint8_t>> tables;
+  for (const auto& pattern : patterns) {
+    tables.push_back(PatternDatabaseBuilder::build(dim, pattern));
+  }
+  return !patterns.empty() && PatternDatabaseBuilder::write(path, dim, patterns, tables);
+}
+
+CATCH_TEST_CASE("PatternDatabase", "[pdb]") {
+  tilepuzzles::TestUtil::init_test();
+  tilepuzzles::Logger L;
+  srand(4);
+
+  CATCH_SECTION("rank is a perfect hash") {
+    std::set<uint64_t> ranks;
+    uint8_t cells[3];
+    uint8_t back[3];
+    for (cells[0] = 0; cells[0] < 9; ++cells[0]) {
+      for (cells[1] = 0; cells[1] < 9; ++cells[1]) {
+        for (cells[2] = 0; cells[2] < 9; ++cells[2]) {
+          if (cells[0] == cells[1] || cells[0] == cells[2] || cells[1] == cells[2]) {
+            continue;
+          }
+          const uint64_t rank = PatternDatabase::rank(cells, 3, 9);
+          CATCH_REQUIRE(rank < PatternDatabase::rankCount(3, 9));
+          ranks.insert(rank);
+          PatternDatabase::unrank(rank, 3, 9, back);
+          CATCH_REQUIRE(std::equal(cells, cells + 3, back));
+        }
+      }
+    }
+    CATCH_REQUIRE(ranks.size() == 9 * 8 * 7);
+  }
+
+  CATCH_SECTION("3x3 tables are admissible everywhere") {
+    const std::string path = "/tmp/test_slider3x3.pdb";
+    CATCH_REQUIRE(buildDatabase(path, 3, {4, 4}));
+    PatternDatabase pdb;
+    CATCH_REQUIRE(pdb.open(path.c_str()));
+    CATCH_REQUIRE(pdb.patterns.size() == 2);
+
+    // exact distances by breadth first search from the goal
+    std::map<std::vector<int>, int> dist;
+    std::queue<std::vector<int>> open;
+    const std::vector<int> goal = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    dist[goal] = 0;
+    open.push(goal);
+    int maxGap = 0;
+    while (!open.empty()) {
+      const std::vector<int> cells = open.front();
+      open.pop();
+      const int d = dist[cells];
+      const int h = pdb.heuristic(positionsOf(cells).data());
+      CATCH_REQUIRE(h <= d);
+      CATCH_REQUIRE(h % 2 == d % 2);
+      maxGap = std::max(maxGap, d - h);
+      const int blank = std::find(cells.begin(), cells.end(), 8) - cells.begin();
+      const int moves[] = {blank - 3, blank + 3, blank % 3 ? blank - 1 : -1, blank % 3 < 2 ? blank + 1 : -1};
+      for (int to : moves) {
+        if (to >= 0 && to <= 8) {
+          std::vector<int> next = cells;
+          std::swap(next[blank], next[to]);
+          if (dist.emplace(next, d + 1).second) {
+            open.push(next);
+          }
+        }
+      }
+    }
+    CATCH_REQUIRE(dist.size() == 181440);
+    L.info("3x3 largest gap to the true distance:", maxGap);
+  }
+
+  CATCH_SECTION("4x4 tables are admissible on random states") {
+    const std::string path = "/tmp/test_slider4x4.pdb";
+    CATCH_REQUIRE(buildDatabase(path, 4, {3, 3, 3, 3, 3}));
+    PatternDatabase pdb;
+    CATCH_REQUIRE(pdb.open(path.c_str()));
+
+    SliderSolver plain;
+    plain.init(4);
+    SliderSolver solver;
+    solver.init(4);
+    solver.setPatternDatabase(&pdb);
+    CATCH_REQUIRE(solver.pdb == &pdb);
+
+    std::vector<int> moves;
+    std::vector<int> plainMoves;
+    for (int i = 0; i < 10; ++i) {
+      std::vector<int> cells = randomWalk(4, 200);
+      CATCH_REQUIRE(plain.solve(cells, plainMoves));
+      CATCH_REQUIRE(solver.solve(cells, moves));
+      CATCH_REQUIRE(moves.size() == plainMoves.size());
+      CATCH_REQUIRE(pdb.heuristic(positionsOf(cells).data()) <= moves.size());
+      // never below Manhattan distance plus linear conflicts, so never a bigger tree
+      CATCH_REQUIRE(solver.nodes <= plain.nodes);
+      L.info("4x4 moves:", moves.size(), "nodes:", solver.nodes, "without pdb:", plain.nodes);
+    }
+  }
+
+  CATCH_SECTION("corrupt file is rejected") {
+    const std::string path = "/tmp/test_corrupt.pdb";
+    FILE* file = fopen(path.c_str(), "wb");
+    fputs("TPDB not a table", file);
+    fclose(file);
+    PatternDatabase pdb;
+    CATCH_REQUIRE(!pdb.open(path.c_str()));
+    CATCH_REQUIRE(!pdb.isOpen());
+  }
+}
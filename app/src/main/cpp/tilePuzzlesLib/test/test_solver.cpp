@@ -0,0 +1,315 @@
+#define CATCH_CONFIG_PREFIX_ALL
+#include "RollerMesh.h"
+#include "RollerSolver.h"
+#include "SliderMesh.h"
+#include "SliderSolver.h"
+#include "GLogger.h"
+#include "TestUtil.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <map>
+#include <queue>
+
+using namespace tilepuzzles;
+
+static std::vector<int> randomWalk(int dim, int length) {
+  std::vector<int> cells(dim * dim);
+  for (int i = 0; i < cells.size(); ++i) {
+    cells[i] = i;
+  }
+  int blank = cells.size() - 1;
+  int prev = -1;
+  for (int i = 0; i < length; ++i) {
+    const int r = blank / dim;
+    const int c = blank % dim;
+    std::vector<int> next;
+    if (r > 0)
+      next.push_back(blank - dim);
+    if (r < dim - 1)
+      next.push_back(blank + dim);
+    if (c > 0)
+      next.push_back(blank - 1);
+    if (c < dim - 1)
+      next.push_back(blank + 1);
+    int to;
+    do {
+      to = next[rand() % next.size()];
+    } while (to == prev);
+    std::swap(cells[blank], cells[to]);
+    prev = blank;
+    blank = to;
+  }
+  return cells;
+}
+
+static bool playsToGoal(std::vector<int> cells, int dim, const std::vector<int>& moves) {
+  int blank = std::find(cells.begin(), cells.end(), cells.size() - 1) - cells.begin();
+  for (int to : moves) {
+    if (abs(to / dim - blank / dim) + abs(to % dim - blank % dim) != 1) {
+      return false;
+    }
+    std::swap(cells[blank], cells[to]);
+    blank = to;
+  }
+  for (int i = 0; i < cells.size(); ++i) {
+    if (cells[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Distance to the goal of every 3x3 board, by breadth first search from the goal.
+static std::map<std::vector<int>, int> distances3x3() {
+  std::map<std::vector<int>, int> dist;
+  std::queue<std::vector<int>> open;
+  std::vector<int> goal = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+  dist[goal] = 0;
+  open.push(goal);
+  while (!open.empty()) {
+    std::vector<int> cells = open.front();
+    open.pop();
+    const int blank = std::find(cells.begin(), cells.end(), 8) - cells.begin();
+    const int moves[] = {blank - 3, blank + 3, blank % 3 ? blank - 1 : -1, blank % 3 < 2 ? blank + 1 : -1};
+    for (int to : moves) {
+      if (to < 0 || to > 8) {
+        continue;
+      }
+      std::vector<int> next = cells;
+      std::swap(next[blank], next[to]);
+      if (dist.emplace(next, dist[cells] + 1).second) {
+        open.push(next);
+      }
+    }
+  }
+  return dist;
+}
+
+CATCH_TEST_CASE("SliderSolver", "[solver]") {
+  tilepuzzles::TestUtil::init_test();
+  tilepuzzles::Logger L;
+  srand(15);
+
+  CATCH_SECTION("unsolvable board is rejected") {
+    SliderSolver solver;
+    solver.init(4);
+    std::vector<int> cells = randomWalk(4, 30);
+    std::swap(cells[cells[0] == 15 ? 1 : 0], cells[cells[2] == 15 ? 3 : 2]);
+    std::vector<int> moves;
+    CATCH_REQUIRE(!SliderSolver::isSolvable(cells, 4));
+    CATCH_REQUIRE(!solver.solve(cells, moves));
+  }
+
+  CATCH_SECTION("3x3 solutions are optimal") {
+    const auto dist = distances3x3();
+    CATCH_REQUIRE(dist.size() == 181440);
+    SliderSolver solver;
+    solver.init(3);
+    std::vector<int> moves;
+    for (int i = 0; i < 200; ++i) {
+      std::vector<int> cells = randomWalk(3, 40 + i);
+      CATCH_REQUIRE(solver.solve(cells, moves));
+      CATCH_REQUIRE(moves.size() == dist.at(cells));
+      CATCH_REQUIRE(playsToGoal(cells, 3, moves));
+    }
+  }
+
+  CATCH_SECTION("4x4") {
+    SliderSolver solver;
+    solver.init(4);
+    std::vector<int> moves;
+    for (int i = 0; i < 20; ++i) {
+      std::vector<int> cells = randomWalk(4, 40);
+      CATCH_REQUIRE(solver.solve(cells, moves));
+      CATCH_REQUIRE(moves.size() <= 40);
+      CATCH_REQUIRE(playsToGoal(cells, 4, moves));
+      L.info("4x4 moves:", moves.size(), "nodes:", solver.nodes);
+    }
+  }
+
+  CATCH_SECTION("parallel search finds optimal solutions") {
+    SliderSolver serial;
+    serial.init(4);
+    SliderSolver parallel;
+    parallel.init(4);
+    parallel.setThreads(4);
+    std::vector<int> moves;
+    std::vector<int> serialMoves;
+    for (int i = 0; i < 20; ++i) {
+      std::vector<int> cells = randomWalk(4, 60);
+      CATCH_REQUIRE(serial.solve(cells, serialMoves));
+      CATCH_REQUIRE(parallel.solve(cells, moves));
+      CATCH_REQUIRE(moves.size() == serialMoves.size());
+      CATCH_REQUIRE(playsToGoal(cells, 4, moves));
+      L.info("4x4 moves:", moves.size(), "nodes:", parallel.nodes, "single thread:", serial.nodes);
+    }
+    std::vector<int> solved = randomWalk(4, 0);
+    CATCH_REQUIRE(parallel.solve(solved, moves));
+    CATCH_REQUIRE(moves.empty());
+  }
+
+  CATCH_SECTION("mesh solve and hint") {
+    SliderMesh mesh;
+    mesh.init(R"({"type":"slider","dimension":{"count":15}})");
+    CATCH_REQUIRE(mesh.hint() == -1);
+    for (int i = 0; i < 60; ++i) {
+      mesh.slideTiles(mesh.tiles[rand() % mesh.tiles.size()]);
+    }
+    std::vector<int> moves;
+    CATCH_REQUIRE(mesh.solve(moves));
+    if (!moves.empty()) {
+      CATCH_REQUIRE(mesh.hint() == mesh.tiles[mesh.board.tileAt(moves.front())].tileNum);
+    }
+    for (int move : moves) {
+      mesh.applyMove(move);
+    }
+    CATCH_REQUIRE(mesh.board.isSolved());
+  }
+
+  CATCH_SECTION("boards above MAX_DIM load without a solver") {
+    SliderSolver solver;
+    CATCH_REQUIRE(!solver.init(SliderSolver::MAX_DIM + 2));
+    std::vector<int> moves;
+    CATCH_REQUIRE(!solver.solve(randomWalk(SliderSolver::MAX_DIM + 2, 0), moves));
+
+    SliderMesh mesh;
+    mesh.init(R"({"type":"slider","dimension":{"count":99}})");
+    CATCH_REQUIRE(mesh.board.rows == 10);
+    mesh.slideTiles(mesh.tiles[mesh.board.tileAt(98)]);
+    CATCH_REQUIRE(!mesh.solve(moves));
+    CATCH_REQUIRE(mesh.hint() == -1);
+  }
+}
+
+static std::vector<int> randomRolls(const RollerSolver& solver, int dim, int length) {
+  std::vector<int> cells(dim * dim);
+  for (int i = 0; i < cells.size(); ++i) {
+    cells[i] = i;
+  }
+  for (int i = 0; i < length; ++i) {
+    solver.apply(RollerSolver::encode(rand() % 2, rand() % dim, rand() % 2 ? 1 : -1), cells.data());
+  }
+  return cells;
+}
+
+static bool rollsToGoal(const RollerSolver& solver, std::vector<int> cells, const std::vector<int>& moves) {
+  for (int move : moves) {
+    solver.apply(move, cells.data());
+  }
+  for (int i = 0; i < cells.size(); ++i) {
+    if (cells[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CATCH_TEST_CASE("RollerSolver", "[solver]") {
+  tilepuzzles::TestUtil::init_test();
+  tilepuzzles::Logger L;
+  srand(21);
+
+  CATCH_SECTION("3x3 solutions are optimal") {
+    RollerSolver solver;
+    solver.init(3);
+    // distance to the goal of every reachable 3x3 board, by breadth first search from the goal
+    std::map<std::vector<int>, int> dist;
+    std::queue<std::vector<int>> open;
+    const std::vector<int> goal = randomRolls(solver, 3, 0);
+    dist[goal] = 0;
+    open.push(goal);
+    while (!open.empty()) {
+      const std::vector<int> cells = open.front();
+      open.pop();
+      for (int line = 0; line < 3; ++line) {
+        for (int column = 0; column < 2; ++column) {
+          for (int step = -1; step <= 1; step += 2) {
+            std::vector<int> next = cells;
+            solver.apply(RollerSolver::encode(column, line, step), next.data());
+            if (dist.emplace(next, dist[cells] + 1).second) {
+              open.push(next);
+            }
+          }
+        }
+      }
+    }
+    CATCH_REQUIRE(dist.size() == 181440);
+
+    std::vector<int> moves;
+    for (int i = 0; i < 200; ++i) {
+      std::vector<int> cells = randomRolls(solver, 3, 30);
+      CATCH_REQUIRE(solver.solve(cells, moves));
+      CATCH_REQUIRE(moves.size() == dist.at(cells));
+      CATCH_REQUIRE(rollsToGoal(solver, cells, moves));
+    }
+    std::vector<int> odd = goal;
+    std::swap(odd[0], odd[1]);
+    CATCH_REQUIRE(!solver.solve(odd, moves));
+    CATCH_REQUIRE(!solver.solveFast(odd, moves));
+  }
+
+  CATCH_SECTION("4x4 shallow boards are solved optimally") {
+    RollerSolver solver;
+    solver.init(4);
+    std::vector<int> moves;
+    for (int i = 0; i < 20; ++i) {
+      std::vector<int> cells = randomRolls(solver, 4, 8);
+      CATCH_REQUIRE(solver.solve(cells, moves));
+      CATCH_REQUIRE(moves.size() <= 8);
+      CATCH_REQUIRE(rollsToGoal(solver, cells, moves));
+      L.info("4x4 roller moves:", moves.size(), "nodes:", solver.nodes);
+    }
+  }
+
+  CATCH_SECTION("large boards are solved with commutators") {
+    for (int dim = 2; dim <= 10; ++dim) {
+      RollerSolver solver;
+      solver.init(dim);
+      std::vector<int> moves;
+      for (int i = 0; i < 5; ++i) {
+        std::vector<int> cells = randomRolls(solver, dim, 1000);
+        const auto start = std::chrono::steady_clock::now();
+        CATCH_REQUIRE(solver.solveFast(cells, moves));
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        CATCH_REQUIRE(rollsToGoal(solver, cells, moves));
+        if (i == 0) {
+          L.info(dim, "x", dim, "roller moves:", moves.size(), "ms:", elapsed.count());
+        }
+      }
+    }
+  }
+
+  CATCH_SECTION("mesh solve and hint") {
+    RollerMesh mesh;
+    mesh.init(R"({"type":"roller","dimension":{"count":25}})");
+    CATCH_REQUIRE(mesh.hint() == -1);
+    mesh.shuffle();
+    std::vector<int> moves;
+    CATCH_REQUIRE(mesh.solve(moves));
+    CATCH_REQUIRE(mesh.hint() >= 0);
+    for (int move : moves) {
+      mesh.applyMove(move);
+    }
+    CATCH_REQUIRE(mesh.board.isSolved());
+  }
+
+  CATCH_SECTION("boards above MAX_DIM load without a solver") {
+    RollerSolver solver;
+    CATCH_REQUIRE(!solver.init(RollerSolver::MAX_DIM + 4));
+
+    RollerMesh mesh;
+    mesh.init(R"({"type":"roller","dimension":{"count":400}})");
+    CATCH_REQUIRE(mesh.board.rows == 20);
+    mesh.shuffle();
+    CATCH_REQUIRE(!mesh.board.isSolved());
+    std::vector<int> sorted = mesh.boardCells();
+    std::sort(sorted.begin(), sorted.end());
+    for (int t = 0; t < sorted.size(); ++t) {
+      CATCH_REQUIRE(sorted[t] == t);
+    }
+    std::vector<int> moves;
+    CATCH_REQUIRE(!mesh.solve(moves));
+    CATCH_REQUIRE(mesh.hint() == -1);
+  }
+}
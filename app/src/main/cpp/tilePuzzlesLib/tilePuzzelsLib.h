@@ -4,6 +4,15 @@
 struct GameContext {
 };
 
+// One touch sample as the Kotlin side packs it into a direct buffer: 16 bytes in native byte order. time is
+// the event time in milliseconds cut to 32 bits, so only differences between samples mean anything.
+struct TouchSample {
+    int action;
+    float x;
+    float y;
+    int time;
+};
+
 GameContext *getContext();
 
 extern "C" {
@@ -12,10 +21,13 @@ void destroy();
 void gameLoop(long frameTimeNanos);
 void render();
 void shuffle();
+int solve();
+int hint();
 void destroySwapChain();
 void createSwapChain(void *nativeWin);
 void resizeWindow(int width, int height);
 void touchAction(int action, float x, float y) ;
+void touchActions(const TouchSample *samples, int count);
 }
 #endif
 
@@ -0,0 +1,158 @@
+// Bakes a source image into a KTX texture with a full mip chain, for IOUtil::textureLoad to pick up in
+// place of decoding the image at runtime.
+//
+//   ktx_baker [--rgba8] [--levels <n>] <image> [<output>]
+//   ktx_baker app/src/main/assets/textures/wood.jpeg
+//
+// The output defaults to the image path plus .ktx. Opaque images are written as RGB8_ETC2, images with
+// alpha as RGBA8_ETC2_EAC; --rgba8 keeps the texels uncompressed. --levels caps the mip chain: the box
+// filter mixes neighboring atlas cells, so the glyph atlases ship with --levels 1.
+#define STB_IMAGE_IMPLEMENTATION
+#include "EtcCodec.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <math.h>
+#include <string>
+#include <vector>
+
+using namespace tilepuzzles;
+
+namespace {
+
+constexpr uint32_t GL_RGB = 0x1907;
+constexpr uint32_t GL_RGBA = 0x1908;
+constexpr uint32_t GL_UNSIGNED_BYTE = 0x1401;
+constexpr uint32_t GL_RGBA8 = 0x8058;
+constexpr uint32_t GL_COMPRESSED_RGB8_ETC2 = 0x9274;
+constexpr uint32_t GL_COMPRESSED_RGBA8_ETC2_EAC = 0x9278;
+
+struct Level {
+  int width;
+  int height;
+  std::vector<uint8_t> rgba;
+};
+
+// 2x2 box filter; an odd last row or column folds into its neighbor.
+Level halve(const Level& level) {
+  Level half = {std::max(1, level.width / 2), std::max(1, level.height / 2)};
+  half.rgba.resize(half.width * half.height * 4);
+  for (int y = 0; y < half.height; ++y) {
+    for (int x = 0; x < half.width; ++x) {
+      for (int c = 0; c < 4; ++c) {
+        int sum = 0;
+        for (int dy = 0; dy < 2; ++dy) {
+          for (int dx = 0; dx < 2; ++dx) {
+            const int sx = std::min(x * 2 + dx, level.width - 1);
+            const int sy = std::min(y * 2 + dy, level.height - 1);
+            sum += level.rgba[(sy * level.width + sx) * 4 + c];
+          }
+        }
+        half.rgba[(y * half.width + x) * 4 + c] = (sum + 2) / 4;
+      }
+    }
+  }
+  return half;
+}
+
+// Over alpha and the color of texels that are not fully transparent, as the encoder weighs them.
+double psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+  double sum = 0;
+  size_t count = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (i % 4 == 3 || a[i / 4 * 4 + 3] != 0) {
+      const double d = double(a[i]) - b[i];
+      sum += d * d;
+      ++count;
+    }
+  }
+  const double mse = sum / count;
+  return mse == 0 ? INFINITY : 10 * log10(255. * 255. / mse);
+}
+
+void put(FILE* file, uint32_t value) {
+  fwrite(&value, sizeof(value), 1, file);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  bool compress = true;
+  size_t maxLevels = SIZE_MAX;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--rgba8") == 0) {
+      compress = false;
+    } else if (strcmp(argv[i], "--levels") == 0 && i + 1 < argc) {
+      maxLevels = std::max(1, atoi(argv[++i]));
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty() || paths.size() > 2) {
+    fprintf(stderr, "usage: %s [--rgba8] [--levels <n>] <image> [<output>]\n", argv[0]);
+    return 1;
+  }
+  const std::string output = paths.size() == 2 ? paths[1] : paths[0] + ".ktx";
+
+  int width, height, channels;
+  uint8_t* data = stbi_load(paths[0].c_str(), &width, &height, &channels, 4);
+  if (data == nullptr) {
+    fprintf(stderr, "could not decode %s\n", paths[0].c_str());
+    return 1;
+  }
+  std::vector<Level> levels = {{width, height, std::vector<uint8_t>(data, data + width * height * 4)}};
+  stbi_image_free(data);
+  while (levels.size() < maxLevels && (levels.back().width > 1 || levels.back().height > 1)) {
+    levels.push_back(halve(levels.back()));
+  }
+
+  bool alpha = false;
+  for (size_t i = 3; i < levels[0].rgba.size(); i += 4) {
+    alpha |= levels[0].rgba[i] != UINT8_MAX;
+  }
+
+  FILE* file = fopen(output.c_str(), "wb");
+  if (file == nullptr) {
+    fprintf(stderr, "could not write %s\n", output.c_str());
+    return 1;
+  }
+  static const uint8_t identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+  fwrite(identifier, 1, sizeof(identifier), file);
+  put(file, 0x04030201);
+  put(file, compress ? 0 : GL_UNSIGNED_BYTE);
+  put(file, 1);
+  put(file, compress ? 0 : GL_RGBA);
+  put(file, compress ? (alpha ? GL_COMPRESSED_RGBA8_ETC2_EAC : GL_COMPRESSED_RGB8_ETC2) : GL_RGBA8);
+  put(file, compress && !alpha ? GL_RGB : GL_RGBA);
+  put(file, width);
+  put(file, height);
+  put(file, 0);
+  put(file, 0);
+  put(file, 1);
+  put(file, levels.size());
+  put(file, 0);
+
+  size_t total = 0;
+  for (const Level& level : levels) {
+    std::vector<uint8_t> blob = compress ? EtcCodec::encode(level.rgba.data(), level.width, level.height, alpha)
+                                         : level.rgba;
+    // every blob is a multiple of 4 bytes, so levels need no padding
+    put(file, blob.size());
+    fwrite(blob.data(), 1, blob.size(), file);
+    total += blob.size();
+    if (compress && &level == &levels[0]) {
+      std::vector<uint8_t> decoded = EtcCodec::decode(blob.data(), level.width, level.height, alpha);
+      printf("level 0 PSNR %.1f dB\n", psnr(level.rgba, decoded));
+    }
+  }
+  fclose(file);
+  printf("wrote %s: %dx%d, %zu levels, %zu bytes of texels against %d as RGBA8\n", output.c_str(), width, height,
+         levels.size(), total, width * height * 4);
+  return 0;
+}
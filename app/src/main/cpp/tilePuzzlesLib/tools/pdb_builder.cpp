@@ -0,0 +1,59 @@
+// Writes the additive pattern databases used by SliderSolver.
+//
+//   pdb_builder <dim> <pattern sizes> <output>
+//   pdb_builder 4 5-5-5 app/src/main/assets/data/slider4x4.pdb
+//
+// Patterns take consecutive tile slots, so 7-8 on 4x4 is tiles 1-7 and 8-15. Sizes must add up to
+// dim * dim - 1. Table size is size!/(size-k)! bytes per pattern; 7-8 on 4x4 needs about 550 MB of tables
+// and several GB of working memory to build.
+#include "PatternDatabaseBuilder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+using namespace tilepuzzles;
+
+int main(int argc, char** argv) {
+  if (argc != 4) {
+    fprintf(stderr, "usage: %s <dim> <pattern sizes, e.g. 6-6-3> <output>\n", argv[0]);
+    return 1;
+  }
+  const int dim = atoi(argv[1]);
+  std::vector<int> sizes;
+  std::stringstream spec(argv[2]);
+  for (std::string size; std::getline(spec, size, '-');) {
+    sizes.push_back(atoi(size.c_str()));
+  }
+  if (dim < 2 || dim > PatternDatabase::MAX_DIM) {
+    fprintf(stderr, "unsupported dimension %d\n", dim);
+    return 1;
+  }
+  const auto patterns = PatternDatabaseBuilder::partition(dim, sizes);
+  if (patterns.empty()) {
+    fprintf(stderr, "pattern sizes must add up to %d\n", dim * dim - 1);
+    return 1;
+  }
+
+  std::vector<std::vector<uint8_t>> tables;
+  for (const auto& pattern : patterns) {
+    const auto start = std::chrono::steady_clock::now();
+    tables.push_back(PatternDatabaseBuilder::build(dim, pattern));
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t total = 0;
+    int maxValue = 0;
+    for (uint8_t v : tables.back()) {
+      total += v;
+      maxValue = v > maxValue ? v : maxValue;
+    }
+    printf("pattern of %zu tiles: %zu entries, mean %.2f, max %d, %.1f s\n", pattern.size(),
+           tables.back().size(), double(total) / tables.back().size(), maxValue, elapsed.count());
+  }
+  if (!PatternDatabaseBuilder::write(argv[3], dim, patterns, tables)) {
+    fprintf(stderr, "could not write %s\n", argv[3]);
+    return 1;
+  }
+  printf("wrote %s\n", argv[3]);
+  return 0;
+}
@@ -0,0 +1,91 @@
+// Times SliderSolver on a fixed set of random boards for each thread count and reports nodes per second
+// and speedup over one thread. Also reports the SliderScrambler rate for the same dimension.
+//
+//   solver_bench <dim> <boards> <thread counts> [pdb]
+//   solver_bench 4 20 1-2-4-8 ../../../assets/data/slider4x4.pdb
+//
+// Boards come from a fixed seed, so runs on different machines use the same instances.
+#include "SliderScrambler.h"
+#include "SliderSolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+using namespace tilepuzzles;
+
+int main(int argc, char** argv) {
+  if (argc != 4 && argc != 5) {
+    fprintf(stderr, "usage: %s <dim> <boards> <thread counts, e.g. 1-2-4> [pdb]\n", argv[0]);
+    return 1;
+  }
+  const int dim = atoi(argv[1]);
+  const int boardCount = atoi(argv[2]);
+  std::vector<int> threadCounts;
+  std::stringstream spec(argv[3]);
+  for (std::string count; std::getline(spec, count, '-');) {
+    threadCounts.push_back(atoi(count.c_str()));
+  }
+  if (dim < 2 || dim > SliderSolver::MAX_DIM || threadCounts.empty()) {
+    fprintf(stderr, "unsupported arguments\n");
+    return 1;
+  }
+  PatternDatabase pdb;
+  if (argc == 5 && !pdb.open(argv[4])) {
+    fprintf(stderr, "could not open %s\n", argv[4]);
+    return 1;
+  }
+
+  std::mt19937 rng(1);
+  std::vector<std::vector<int>> boards;
+  while (boards.size() < boardCount) {
+    std::vector<int> cells(dim * dim);
+    for (int i = 0; i < cells.size(); ++i) {
+      cells[i] = i;
+    }
+    std::shuffle(cells.begin(), cells.end(), rng);
+    if (SliderSolver::isSolvable(cells, dim)) {
+      boards.push_back(cells);
+    }
+  }
+
+  SliderScrambler scrambler(1);
+  std::vector<uint16_t> scrambled(dim * dim);
+  const int scrambles = 1000000;
+  int checksum = 0;
+  const auto scrambleStart = std::chrono::steady_clock::now();
+  for (int i = 0; i < scrambles; ++i) {
+    scrambler.scramble(dim, scrambled.data());
+    checksum += scrambled[0];
+  }
+  const std::chrono::duration<double> scrambleTime = std::chrono::steady_clock::now() - scrambleStart;
+  printf("scrambles: %.1f M boards/s (checksum %d)\n", scrambles / scrambleTime.count() / 1e6, checksum);
+
+  double baseSeconds = 0;
+  for (int threads : threadCounts) {
+    SliderSolver solver;
+    solver.init(dim);
+    solver.setPatternDatabase(pdb.isOpen() ? &pdb : nullptr);
+    solver.setThreads(threads);
+    uint64_t nodes = 0;
+    int moveTotal = 0;
+    std::vector<int> moves;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& cells : boards) {
+      solver.solve(cells, moves);
+      nodes += solver.nodes;
+      moveTotal += moves.size();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (baseSeconds == 0) {
+      baseSeconds = elapsed.count();
+    }
+    printf("threads %d: %d moves, %llu nodes, %.2f s, %.1f M nodes/s, speedup %.2f\n", threads, moveTotal,
+           (unsigned long long)nodes, elapsed.count(), nodes / elapsed.count() / 1e6,
+           baseSeconds / elapsed.count());
+  }
+  return 0;
+}
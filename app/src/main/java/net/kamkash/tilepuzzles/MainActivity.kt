@@ -9,6 +9,8 @@ import android.view.*
 import android.widget.ImageButton
 import androidx.appcompat.app.AppCompatActivity
 import net.kamkash.tilepuzzles.databinding.ActivityMainBinding
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
 
 
 class MainActivity : AppCompatActivity(), Choreographer.FrameCallback {
@@ -19,6 +21,7 @@ class MainActivity : AppCompatActivity(), Choreographer.FrameCallback {
     private lateinit var mUiHelper: TUiHelper
     private var mVisisbleFrame: Rect = Rect()
     private lateinit var binding: ActivityMainBinding
+    private var touchSamples: ByteBuffer = allocateTouchSamples(32)
 
 
     override fun onCreate(savedInstanceState: Bundle?) {
@@ -43,17 +46,16 @@ class MainActivity : AppCompatActivity(), Choreographer.FrameCallback {
             when (event!!.action) {
                 MotionEvent.ACTION_DOWN -> {
                     Log.d(LOG_TAG, "Action was DOWN: ${event.x}, ${event.y}")
-                    touchAction(event.action, event.x, event.y)
+                    sendTouchSamples(event)
                     true
                 }
                 MotionEvent.ACTION_MOVE -> {
-                    Log.d(LOG_TAG, "Action was MOVE: ${event.x}, ${event.y}")
-                    touchAction(event.action, event.x, event.y)
+                    sendTouchSamples(event)
                     true
                 }
                 MotionEvent.ACTION_UP -> {
                     Log.d(LOG_TAG, "Action was UP: ${event.x}, ${event.y}")
-                    touchAction(event.action, event.x, event.y)
+                    sendTouchSamples(event)
                     v.performClick()
                     true
                 }
@@ -73,6 +75,27 @@ class MainActivity : AppCompatActivity(), Choreographer.FrameCallback {
         windowVisibleDisplayFrame()
     }
 
+    // The event's historical points and its current one go over JNI in a single call, packed as
+    // TouchSample records (action, x, y, time) of TOUCH_SAMPLE_SIZE bytes.
+    private fun sendTouchSamples(event: MotionEvent) {
+        val count = event.historySize + 1
+        if (touchSamples.capacity() < count * TOUCH_SAMPLE_SIZE) {
+            touchSamples = allocateTouchSamples(count * 2)
+        }
+        touchSamples.clear()
+        for (h in 0 until event.historySize) {
+            touchSamples.putInt(event.action)
+                .putFloat(event.getHistoricalX(h))
+                .putFloat(event.getHistoricalY(h))
+                .putInt(event.getHistoricalEventTime(h).toInt())
+        }
+        touchSamples.putInt(event.action).putFloat(event.x).putFloat(event.y).putInt(event.eventTime.toInt())
+        touchActions(touchSamples, count)
+    }
+
+    private fun allocateTouchSamples(count: Int): ByteBuffer =
+        ByteBuffer.allocateDirect(count * TOUCH_SAMPLE_SIZE).order(ByteOrder.nativeOrder())
+
     private fun windowVisibleDisplayFrame() {
         val window = window
         window.decorView.getWindowVisibleDisplayFrame(mVisisbleFrame)
@@ -140,10 +163,15 @@ class MainActivity : AppCompatActivity(), Choreographer.FrameCallback {
     external fun init(assetManager: AssetManager): Unit
     external fun destroy(): Unit
     external fun shuffle(): Unit
+    external fun solve(): Int
+    external fun hint(): Int
     external fun gameLoop(frameTimeNanos: Long): Unit
     external fun touchAction(action: Int, rawX: Float, rawY: Float): Unit
+    external fun touchActions(samples: ByteBuffer, count: Int): Unit
 
     companion object {
+        private const val TOUCH_SAMPLE_SIZE = 16
+
         // Used to load the 'tilepuzzles' library on application startup.
         init {
             System.loadLibrary("tilepuzzles")